@@ -0,0 +1,373 @@
+#include "benchmark.h"
+
+#include "commons.h"
+#include "decompose.h"
+#include "dft.h"
+#include "filter.h"
+#include "generate.h"
+#include "logger.h"
+#include "smooth.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <complex>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+/**
+ * @brief kUsage - описание параметров запуска.
+ */
+const char kUsage[] =
+    "Usage: fourier_bench [options]\n"
+    "Options:\n"
+    "  --lengths=<n,...>       signal lengths (default 100,1000,10000,100000,1000000; up to 10000000)\n"
+    "  --frequencies=<n,...>   base frequencies counts for generate and decompose (default 1,4)\n"
+    "  --filter=<text>         run only benchmarks whose name contains text\n"
+    "  --min-time=<seconds>    minimum measured time of each benchmark (default 0.2)\n"
+    "  --threads=<n>           threads of generate and decompose (default 1, 0 - all cores)\n"
+    "  --json=<file>           write results as JSON to file ('-' - to stdout instead of the table)\n"
+    "  --label=<text>          label stored in the JSON context (e.g. branch or commit name)";
+
+/**
+ * @brief kFrequencies - множители частот базовых сигналов (первые значения - частоты примера в main).
+ */
+const double kFrequencies[] = { 5.0, 2.0, 10.0, 5.5, 3.0, 7.5, 12.0, 4.0 };
+const size_t kFrequenciesTableSize = sizeof(kFrequencies) / sizeof(kFrequencies[0]);
+
+/**
+ * @struct Arguments
+ * @brief Параметры запуска.
+ */
+struct Arguments
+{
+    std::vector<size_t> lengths = { 100, 1000, 10000, 100000, 1000000 };
+    std::vector<size_t> frequenciesCounts = { 1, 4 };
+    std::string filter;
+    bench::MeasureOptions measure;
+    size_t threadsCount = 1;
+    std::string jsonFileName;
+    std::string label;
+    bool isValid = true;
+};
+
+bool parseSize(const std::string& text, size_t& value)
+{
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long kValue = std::strtoull(text.c_str(), &end, 10);
+    if (text.empty() || text[0] == '-' || *end != '\0' || errno != 0)
+    {
+        return false;
+    }
+
+    value = static_cast<size_t>(kValue);
+    return true;
+}
+
+/**
+ * @brief parseSizes - разбирает список положительных чисел через запятую.
+ */
+bool parseSizes(const std::string& text, std::vector<size_t>& values)
+{
+    values.clear();
+    size_t first = 0;
+    while (first <= text.size())
+    {
+        const size_t kComma = std::min(text.find(',', first), text.size());
+        size_t value = 0;
+        if (!::parseSize(text.substr(first, kComma - first), value) || value == 0)
+        {
+            return false;
+        }
+        values.push_back(value);
+        first = kComma + 1;
+    }
+    return !values.empty();
+}
+
+Arguments parseArguments(const int argc, char* argv[])
+{
+    Arguments result;
+    for (int index = 1; index < argc; ++index)
+    {
+        const std::string kArgument(argv[index]);
+        const size_t kEqual = kArgument.find('=');
+        const std::string kName = kArgument.substr(0, kEqual);
+        const std::string kValue = (kEqual != std::string::npos ? kArgument.substr(kEqual + 1) : std::string());
+
+        bool isValid = true;
+        if (kName == "--lengths")
+        {
+            isValid = ::parseSizes(kValue, result.lengths);
+        }
+        else if (kName == "--frequencies")
+        {
+            isValid = ::parseSizes(kValue, result.frequenciesCounts);
+        }
+        else if (kName == "--filter")
+        {
+            result.filter = kValue;
+        }
+        else if (kName == "--min-time")
+        {
+            char* end = nullptr;
+            result.measure.minTime = std::strtod(kValue.c_str(), &end);
+            isValid = (!kValue.empty() && *end == '\0' && result.measure.minTime >= 0.0);
+        }
+        else if (kName == "--threads")
+        {
+            isValid = ::parseSize(kValue, result.threadsCount);
+        }
+        else if (kName == "--json")
+        {
+            result.jsonFileName = kValue;
+            isValid = !kValue.empty();
+        }
+        else if (kName == "--label")
+        {
+            result.label = kValue;
+        }
+        else
+        {
+            isValid = false;
+        }
+
+        if (!isValid)
+        {
+            Logger::error("Invalid option '" + kArgument + "'.");
+            result.isValid = false;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief frequencies - первые count множителей частот базовых сигналов.
+ */
+std::vector<double> frequencies(const size_t count)
+{
+    std::vector<double> result;
+    for (size_t i = 0; i < count; ++i)
+    {
+        result.push_back(i < kFrequenciesTableSize ? kFrequencies[i]
+                                                   : kFrequencies[i % kFrequenciesTableSize] + 0.25 * (i / kFrequenciesTableSize));
+    }
+    return result;
+}
+
+/**
+ * @brief makeBaseSignals - базовые сигналы с частотами frequencies: каждый включён на всей длине сигнала,
+ *        кроме своей части (выключенные части разных сигналов не совпадают), и имеет свою громкость.
+ */
+std::vector<SineSignal> makeBaseSignals(const size_t length, const std::vector<double>& frequencies)
+{
+    std::vector<SineSignal> result(frequencies.size());
+    for (size_t i = 0; i < frequencies.size(); ++i)
+    {
+        SineSignal& each = result[i];
+        each.sine.freqFactor = frequencies[i];
+        each.sine.startPhase = 0.5 * i;
+
+        const double kVolume = SineBehaviour::kVolumeMax - i * (SineBehaviour::kVolumeMax - SineBehaviour::kVolumeMin) / frequencies.size();
+        each.behaviour = BehaviourTimeline(length, SineBehaviour{ kVolume, true });
+
+        const size_t kOffFirst = length * i / frequencies.size();
+        const size_t kOffLast = kOffFirst + length / (2 * frequencies.size());
+        each.behaviour.fill(kOffFirst, kOffLast, SineBehaviour{ kVolume, false });
+    }
+    return result;
+}
+
+/**
+ * @class Suite
+ * @brief Набор тестов: запускает тесты, подходящие под фильтр, и собирает результаты.
+ *        Сигналы каждой длины генерируются один раз и используются всеми тестами.
+ */
+class Suite
+{
+public:
+    explicit Suite(const Arguments& arguments) :
+        m_arguments(arguments)
+    { }
+
+    const std::vector<bench::Result>& results() const { return m_results; }
+
+    /**
+     * @brief run - замеряет тест name с параметрами parameters; body получает параметры и возвращает замеряемое действие.
+     */
+    void run(const std::string& name,
+             const bench::Parameters& parameters,
+             const std::function<std::function<void()>(const bench::Parameters&)>& body)
+    {
+        if (!m_arguments.filter.empty() && name.find(m_arguments.filter) == std::string::npos)
+        {
+            return;
+        }
+
+        m_results.push_back(bench::measure(name, parameters, body(parameters), m_arguments.measure));
+        if (m_arguments.jsonFileName != "-")
+        {
+            bench::writeTableRow(std::cout, m_results.back());
+        }
+    }
+
+    /**
+     * @brief signal - сложный сигнал длиной length (четыре базовых сигнала с шумом).
+     */
+    const std::vector<double>& signal(const size_t length)
+    {
+        std::vector<double>& result = m_signals[length];
+        if (result.empty())
+        {
+            GenerateOptions options;
+            options.noiseEnabled = true;
+            result = generate(length, ::makeBaseSignals(length, ::frequencies(4)), options);
+        }
+        return result;
+    }
+
+private:
+    const Arguments& m_arguments;
+    std::vector<bench::Result> m_results;
+    std::map<size_t, std::vector<double>> m_signals;
+};
+
+/**
+ * @brief runBenchmarks - замеряет преобразования Фурье, фильтры, генерацию, сглаживание и декомпозицию
+ *        для всех длин сигнала (и количеств частот - для генерации и декомпозиции).
+ */
+void runBenchmarks(Suite& suite, const Arguments& arguments)
+{
+    for (const size_t kLength : arguments.lengths)
+    {
+        const bench::Parameters kParameters{ kLength, 1 };
+        const std::vector<double>& kSignal = suite.signal(kLength);
+
+        suite.run("dft", kParameters, [&kSignal](const bench::Parameters&)
+        {
+            return [&kSignal]() { bench::keep(fourier::dft(kSignal)); };
+        });
+
+        suite.run("inverseDft", kParameters, [&kSignal](const bench::Parameters&)
+        {
+            const std::vector<std::complex<double>> kSpectrum = fourier::dft(kSignal);
+            return [kSpectrum]() { bench::keep(fourier::inverseDft(kSpectrum)); };
+        });
+
+        suite.run("filterByFrequency", kParameters, [&kSignal](const bench::Parameters&)
+        {
+            return [&kSignal]() { bench::keep(filterByFrequency(kSignal, kFrequencies[0])); };
+        });
+
+        suite.run("lowPassFilter", kParameters, [&kSignal](const bench::Parameters&)
+        {
+            return [&kSignal]() { bench::keep(lowPassFilterByFrequency(kSignal, kFrequencies[0])); };
+        });
+
+        suite.run("highPassFilter", kParameters, [&kSignal](const bench::Parameters&)
+        {
+            return [&kSignal]() { bench::keep(highPassFilterByFrequency(kSignal, kFrequencies[0])); };
+        });
+
+        suite.run("movingAverage", kParameters, [&kSignal](const bench::Parameters&)
+        {
+            std::shared_ptr<std::vector<double>> output = std::make_shared<std::vector<double>>(kSignal.size());
+            return [&kSignal, output]()
+            {
+                smoothing::movingAverage(kSignal, frequencyToPeriod(kFrequencies[0]), *output);
+                bench::keep(*output);
+            };
+        });
+
+        for (const size_t kFrequenciesCount : arguments.frequenciesCounts)
+        {
+            const bench::Parameters kFrequencyParameters{ kLength, kFrequenciesCount };
+
+            suite.run("generate", kFrequencyParameters, [&arguments](const bench::Parameters& parameters)
+            {
+                const std::vector<SineSignal> kBaseSignals = ::makeBaseSignals(parameters.length,
+                                                                               ::frequencies(parameters.frequenciesCount));
+                GenerateOptions options;
+                options.noiseEnabled = true;
+                options.threadsCount = arguments.threadsCount;
+                const size_t kLength = parameters.length;
+                return [kBaseSignals, options, kLength]() { bench::keep(generate(kLength, kBaseSignals, options)); };
+            });
+
+            suite.run("decompose", kFrequencyParameters, [&arguments](const bench::Parameters& parameters)
+            {
+                const std::vector<double> kFrequenciesValues = ::frequencies(parameters.frequenciesCount);
+                GenerateOptions generateOptions;
+                generateOptions.noiseEnabled = true;
+                std::shared_ptr<std::vector<double>> signal = std::make_shared<std::vector<double>>(
+                    generate(parameters.length, ::makeBaseSignals(parameters.length, kFrequenciesValues), generateOptions));
+
+                DecomposeOptions options;
+                options.threadsCount = arguments.threadsCount;
+                options.probabilitiesFileName.clear(); // Замеряется анализ, а не запись файла.
+                return [signal, kFrequenciesValues, options]()
+                {
+                    bench::keep(decompose(*signal, kFrequenciesValues, options));
+                };
+            });
+        }
+    }
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    const Arguments kArguments = ::parseArguments(argc, argv);
+    if (!kArguments.isValid)
+    {
+        Logger::info(kUsage);
+        return EXIT_FAILURE;
+    }
+
+    // Сообщения декомпозиции не должны попадать в замеры.
+    Logger::setLevel(LogLevel::Warning);
+
+    bench::Context context = bench::currentContext();
+    context.label = kArguments.label;
+    context.threadsCount = (kArguments.threadsCount != 0 ? kArguments.threadsCount : ThreadPool::defaultThreadsCount());
+    if (!context.isOptimized && kArguments.jsonFileName != "-")
+    {
+        Logger::warning("fourier_bench is built without optimization: use -DCMAKE_BUILD_TYPE=Release for representative results.");
+        Logger::flush();
+    }
+
+    Suite suite(kArguments);
+    if (kArguments.jsonFileName != "-")
+    {
+        bench::writeTableRow(std::cout, bench::Result(), true);
+    }
+    ::runBenchmarks(suite, kArguments);
+
+    if (kArguments.jsonFileName == "-")
+    {
+        bench::writeJson(std::cout, context, suite.results());
+    }
+    else if (!kArguments.jsonFileName.empty())
+    {
+        std::ofstream out(kArguments.jsonFileName);
+        bench::writeJson(out, context, suite.results());
+        if (!out.good())
+        {
+            Logger::error(kArguments.jsonFileName + ": " + strerror(errno));
+            return EXIT_FAILURE;
+        }
+        Logger::info("Writed " + kArguments.jsonFileName);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,258 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <thread>
+
+namespace
+{
+std::atomic<size_t> gAllocationsCount{ 0 };
+std::atomic<size_t> gAllocatedBytes{ 0 };
+
+void* allocate(const size_t size)
+{
+    gAllocationsCount.fetch_add(1, std::memory_order_relaxed);
+    gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size != 0 ? size : 1);
+}
+
+/**
+ * @brief escapeJson - текст value как строка JSON (в кавычках).
+ */
+std::string escapeJson(const std::string& value)
+{
+    std::string result = "\"";
+    for (const char each : value)
+    {
+        if (each == '"' || each == '\\')
+        {
+            result += '\\';
+            result += each;
+        }
+        else if (static_cast<unsigned char>(each) < 0x20)
+        {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(each));
+            result += code;
+        }
+        else
+        {
+            result += each;
+        }
+    }
+    return result + "\"";
+}
+
+std::string formatNumber(const double value)
+{
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.6g", value);
+    return text;
+}
+
+}
+
+// Замена глобальных операторов выделения памяти подсчитывает выделения всех частей программы (включая библиотеку).
+void* operator new(size_t size)
+{
+    void* const kPointer = ::allocate(size);
+    if (kPointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return kPointer;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return ::allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return ::allocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    std::free(pointer);
+}
+
+namespace bench
+{
+
+Context currentContext()
+{
+    Context result;
+#ifdef FOURIER_BENCH_REVISION
+    result.revision = FOURIER_BENCH_REVISION;
+#endif
+#if defined(__clang__)
+    result.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    result.compiler = "gcc " __VERSION__;
+#else
+    result.compiler = "unknown";
+#endif
+#ifdef __OPTIMIZE__
+    result.isOptimized = true;
+#endif
+    result.hardwareThreads = std::thread::hardware_concurrency();
+
+    const std::time_t kNow = std::time(nullptr);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&kNow));
+    result.time = text;
+
+    return result;
+}
+
+AllocationCounters allocationCounters()
+{
+    AllocationCounters result;
+    result.count = gAllocationsCount.load(std::memory_order_relaxed);
+    result.bytes = gAllocatedBytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+void keepPointer(const void* pointer)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r"(pointer) : "memory");
+#else
+    static const void* volatile sink = nullptr;
+    sink = pointer;
+#endif
+}
+
+Result measure(const std::string& name,
+               const Parameters& parameters,
+               const std::function<void()>& body,
+               const MeasureOptions& options)
+{
+    using Clock = std::chrono::steady_clock;
+
+    body();
+
+    Result result;
+    result.name = name;
+    result.parameters = parameters;
+
+    size_t iterations = std::max<size_t>(options.minIterations, 1);
+    while (true)
+    {
+        const AllocationCounters kAllocationsBefore = allocationCounters();
+        const Clock::time_point kStart = Clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            body();
+        }
+        const double kSeconds = std::chrono::duration<double>(Clock::now() - kStart).count();
+        const AllocationCounters kAllocationsAfter = allocationCounters();
+
+        if (kSeconds >= options.minTime)
+        {
+            result.iterations = iterations;
+            result.nsPerIteration = kSeconds * 1.0e9 / iterations;
+            result.nsPerSample = result.nsPerIteration / std::max<size_t>(parameters.length, 1);
+            result.samplesPerSecond = (kSeconds > 0.0 ? parameters.length * iterations / kSeconds : 0.0);
+            result.allocationsPerIteration = static_cast<double>(kAllocationsAfter.count - kAllocationsBefore.count) / iterations;
+            result.allocatedBytesPerIteration = static_cast<double>(kAllocationsAfter.bytes - kAllocationsBefore.bytes) / iterations;
+            return result;
+        }
+
+        // Следующая серия должна продлиться не меньше minTime (с запасом), но не более чем в 10 раз дольше текущей.
+        const double kFactor = (kSeconds > 0.0 ? 1.4 * options.minTime / kSeconds : 10.0);
+        iterations = static_cast<size_t>(iterations * std::min(std::max(kFactor, 2.0), 10.0));
+    }
+}
+
+void writeTableRow(std::ostream& out, const Result& result, const bool isHeader)
+{
+    char line[256];
+    if (isHeader)
+    {
+        std::snprintf(line, sizeof(line), "%-18s %10s %6s %10s %14s %11s %12s %12s %14s\n",
+                      "benchmark", "length", "freqs", "iterations", "ns/iteration", "ns/sample",
+                      "Msamples/s", "allocs/iter", "bytes/iter");
+    }
+    else
+    {
+        std::snprintf(line, sizeof(line), "%-18s %10zu %6zu %10zu %14.0f %11.3f %12.3f %12.1f %14.0f\n",
+                      result.name.c_str(), result.parameters.length, result.parameters.frequenciesCount,
+                      result.iterations, result.nsPerIteration, result.nsPerSample, result.samplesPerSecond / 1.0e6,
+                      result.allocationsPerIteration, result.allocatedBytesPerIteration);
+    }
+    out << line << std::flush;
+}
+
+void writeJson(std::ostream& out, const Context& context, const std::vector<Result>& results)
+{
+    out << "{\n"
+        << "  \"context\": {\n"
+        << "    \"label\": " << ::escapeJson(context.label) << ",\n"
+        << "    \"revision\": " << ::escapeJson(context.revision) << ",\n"
+        << "    \"compiler\": " << ::escapeJson(context.compiler) << ",\n"
+        << "    \"optimized\": " << (context.isOptimized ? "true" : "false") << ",\n"
+        << "    \"threads\": " << context.threadsCount << ",\n"
+        << "    \"hardware_threads\": " << context.hardwareThreads << ",\n"
+        << "    \"time\": " << ::escapeJson(context.time) << "\n"
+        << "  },\n"
+        << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const Result& each = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {"
+            << " \"name\": " << ::escapeJson(each.name)
+            << ", \"length\": " << each.parameters.length
+            << ", \"frequencies\": " << each.parameters.frequenciesCount
+            << ", \"iterations\": " << each.iterations
+            << ", \"ns_per_iteration\": " << ::formatNumber(each.nsPerIteration)
+            << ", \"ns_per_sample\": " << ::formatNumber(each.nsPerSample)
+            << ", \"samples_per_second\": " << ::formatNumber(each.samplesPerSecond)
+            << ", \"allocations_per_iteration\": " << ::formatNumber(each.allocationsPerIteration)
+            << ", \"allocated_bytes_per_iteration\": " << ::formatNumber(each.allocatedBytesPerIteration)
+            << " }";
+    }
+
+    out << (results.empty() ? "]\n" : "\n  ]\n") << "}\n";
+}
+
+} // bench
@@ -0,0 +1,117 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+/**
+ * @struct Parameters
+ * @brief Параметры замера: длина сигнала и количество частот (базовых сигналов).
+ */
+struct Parameters
+{
+    size_t length = 0;
+    size_t frequenciesCount = 0;
+};
+
+/**
+ * @struct Result
+ * @brief Результат замера одного теста с параметрами parameters.
+ */
+struct Result
+{
+    std::string name;
+    Parameters parameters;
+    size_t iterations = 0;
+    double nsPerIteration = 0.0;
+    double nsPerSample = 0.0;
+    double samplesPerSecond = 0.0;
+    double allocationsPerIteration = 0.0;     //!< Вызовов operator new за итерацию (во всех потоках).
+    double allocatedBytesPerIteration = 0.0;  //!< Запрошенных байт за итерацию.
+};
+
+/**
+ * @struct MeasureOptions
+ * @brief Параметры замера.
+ */
+struct MeasureOptions
+{
+    double minTime = 0.2;     //!< Наименьшая длительность замеряемой серии итераций (в секундах).
+    size_t minIterations = 1; //!< Наименьшее количество итераций серии.
+};
+
+/**
+ * @struct Context
+ * @brief Условия запуска, записываемые вместе с результатами для сравнения замеров разных версий.
+ */
+struct Context
+{
+    std::string label;        //!< Произвольная пометка запуска.
+    std::string revision;     //!< Версия исходного кода (git), для которой выполнена сборка.
+    std::string compiler;
+    bool isOptimized = false; //!< Собрана ли программа с оптимизацией.
+    size_t threadsCount = 1;  //!< Количество потоков тестов.
+    size_t hardwareThreads = 0;
+    std::string time;         //!< Время запуска (UTC, ISO 8601).
+};
+
+/**
+ * @brief currentContext - условия текущего запуска (поля label и threadsCount заполняются вызывающим).
+ */
+Context currentContext();
+
+/**
+ * @struct AllocationCounters
+ * @brief Счётчики выделений памяти operator new с начала работы программы.
+ */
+struct AllocationCounters
+{
+    size_t count = 0;
+    size_t bytes = 0;
+};
+
+AllocationCounters allocationCounters();
+
+/**
+ * @brief keepPointer, keep - не позволяют компилятору исключить вычисление значения как неиспользуемого.
+ */
+void keepPointer(const void* pointer);
+
+template <typename T>
+void keep(const T& value)
+{
+    keepPointer(&value);
+}
+
+/**
+ * @brief measure - замеряет время выполнения body: после пробного вызова (заполнение кэшей и планов преобразований)
+ *        серии из растущего количества итераций выполняются, пока серия не продлится options.minTime.
+ * @param name - название теста.
+ * @param parameters - параметры замера (длина сигнала определяет время на отсчёт).
+ * @param body - замеряемое действие (одна итерация).
+ * @param options - параметры замера.
+ * @return результат последней серии.
+ */
+Result measure(const std::string& name,
+               const Parameters& parameters,
+               const std::function<void()>& body,
+               const MeasureOptions& options = MeasureOptions());
+
+/**
+ * @brief writeTableRow - выводит строку таблицы для результата result (заголовок - при isHeader).
+ */
+void writeTableRow(std::ostream& out, const Result& result, const bool isHeader = false);
+
+/**
+ * @brief writeJson - записывает условия запуска context и результаты results в формате JSON.
+ */
+void writeJson(std::ostream& out, const Context& context, const std::vector<Result>& results);
+
+} // bench
+
+#endif // BENCHMARK_H
@@ -0,0 +1,67 @@
+#ifndef ALIGNED_H
+#define ALIGNED_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/**
+ * @brief kCacheLineSize - размер строки кэша процессора (в байтах), по которому выравниваются буферы данных.
+ */
+const size_t kCacheLineSize = 64;
+
+/**
+ * @class AlignedAllocator
+ * @brief Распределитель памяти для стандартных контейнеров, выравнивающий начало буфера по границе Alignment байт
+ *        (C++14 не поддерживает выравнивание сверх alignof(std::max_align_t) в operator new).
+ *        Исходный указатель хранится непосредственно перед выровненным буфером.
+ */
+template <typename T, size_t Alignment = kCacheLineSize>
+class AlignedAllocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    { }
+
+    T* allocate(const size_t count)
+    {
+        void* const kRaw = ::operator new(count * sizeof(T) + Alignment + sizeof(void*));
+        const uintptr_t kAligned = (reinterpret_cast<uintptr_t>(kRaw) + sizeof(void*) + Alignment - 1)
+                                 & ~static_cast<uintptr_t>(Alignment - 1);
+        reinterpret_cast<void**>(kAligned)[-1] = kRaw;
+        return reinterpret_cast<T*>(kAligned);
+    }
+
+    void deallocate(T* pointer, const size_t)
+    {
+        ::operator delete(reinterpret_cast<void**>(pointer)[-1]);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+/**
+ * @brief AlignedVector - вектор с буфером, выровненным по строке кэша.
+ */
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+#endif // ALIGNED_H
@@ -0,0 +1,208 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * Кэши вычисленных значений, разделяемые между потоками.
+ */
+namespace cache
+{
+/**
+ * @struct Statistics
+ * @brief Счётчики использования кэша (для подбора его размера).
+ */
+struct Statistics
+{
+    size_t hits = 0;       //!< Количество запросов, найденных в кэше.
+    size_t misses = 0;     //!< Количество запросов, потребовавших вычисления значения.
+    size_t evictions = 0;  //!< Количество значений, вытесненных из-за превышения бюджета.
+    size_t entries = 0;    //!< Текущее количество значений.
+    size_t bytes = 0;      //!< Текущий объём значений (в байтах).
+    size_t bytesLimit = 0; //!< Бюджет кэша (в байтах).
+};
+
+/**
+ * @brief quantize - приводит действительный ключ value к целому числу шагов step,
+ *        чтобы близкие (в пределах step) значения попадали в одну запись кэша.
+ */
+inline long long quantize(const double value, const double step)
+{
+    return std::llround(value / step);
+}
+
+/**
+ * @brief valueBytes - объём памяти, занимаемый значением кэша (в байтах).
+ */
+template <typename T>
+size_t valueBytes(const std::vector<T>& value)
+{
+    return sizeof(value) + value.capacity() * sizeof(T);
+}
+
+/**
+ * @class LruCache
+ * @brief Потокобезопасный кэш с ограничением суммарного объёма значений и вытеснением
+ *        давно не использованных значений (LRU).
+ *        Значения хранятся как std::shared_ptr<const Value> и выдаются без копирования;
+ *        вытесненное значение остаётся действительным, пока на него есть ссылки.
+ *        Поиск выполняется под разделяемой блокировкой, поэтому читатели не мешают друг другу;
+ *        исключительная блокировка берётся только для вставки нового значения.
+ *
+ * @note Объём значения определяется функцией valueBytes (поиск по ADL).
+ */
+template <typename Key, typename Value>
+class LruCache
+{
+public:
+    using ValuePtr = std::shared_ptr<const Value>;
+
+    /**
+     * @brief LruCache - создаёт кэш с бюджетом bytesLimit байт.
+     */
+    explicit LruCache(const size_t bytesLimit) :
+        m_bytesLimit(bytesLimit)
+    { }
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    /**
+     * @brief get - возвращает значение с ключом key, вычисляя его вызовом make() при отсутствии в кэше.
+     *        Вычисление выполняется без блокировки кэша; если значение за это время вычислил другой поток,
+     *        возвращается уже сохранённое значение.
+     *        Только что вставленное значение не вытесняется, даже если оно одно превышает бюджет.
+     * @param key - ключ значения.
+     * @param make - функция без аргументов, возвращающая значение типа Value.
+     * @return разделяемое неизменяемое значение.
+     */
+    template <typename Factory>
+    ValuePtr get(const Key& key, Factory&& make)
+    {
+        {
+            std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+            const auto kFounded = m_entries.find(key);
+            if (kFounded != std::end(m_entries))
+            {
+                kFounded->second.lastUse.store(nextTick(), std::memory_order_relaxed);
+                m_hits.fetch_add(1, std::memory_order_relaxed);
+                return kFounded->second.value;
+            }
+        }
+
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        ValuePtr value = std::make_shared<const Value>(make());
+        const size_t kBytes = valueBytes(*value);
+
+        std::unique_lock<std::shared_timed_mutex> lock(m_mutex);
+        const auto kInserted = m_entries.emplace(std::piecewise_construct,
+                                                 std::forward_as_tuple(key),
+                                                 std::forward_as_tuple(value, kBytes, nextTick()));
+        if (!kInserted.second)
+        {
+            kInserted.first->second.lastUse.store(nextTick(), std::memory_order_relaxed);
+            return kInserted.first->second.value;
+        }
+
+        m_bytes += kBytes;
+        evict(kInserted.first);
+        return value;
+    }
+
+    /**
+     * @brief statistics - текущие значения счётчиков кэша.
+     */
+    Statistics statistics() const
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(m_mutex);
+
+        Statistics result;
+        result.hits = m_hits.load(std::memory_order_relaxed);
+        result.misses = m_misses.load(std::memory_order_relaxed);
+        result.evictions = m_evictions;
+        result.entries = m_entries.size();
+        result.bytes = m_bytes;
+        result.bytesLimit = m_bytesLimit;
+        return result;
+    }
+
+    /**
+     * @brief clear - удаляет все значения кэша (выданные ранее значения остаются действительными).
+     */
+    void clear()
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(m_mutex);
+        m_entries.clear();
+        m_bytes = 0;
+    }
+
+private:
+    struct Entry
+    {
+        ValuePtr value;
+        size_t bytes = 0;
+        std::atomic<uint64_t> lastUse; //!< Момент последнего обращения (обновляется под разделяемой блокировкой).
+
+        Entry(const ValuePtr& entryValue, const size_t entryBytes, const uint64_t tick) :
+            value(entryValue),
+            bytes(entryBytes),
+            lastUse(tick)
+        { }
+    };
+
+    using Entries = std::map<Key, Entry>;
+
+    uint64_t nextTick()
+    {
+        return m_clock.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief evict - вытесняет давно не использованные значения (кроме keep), пока объём превышает бюджет.
+     *        Вызывается под исключительной блокировкой.
+     */
+    void evict(const typename Entries::iterator keep)
+    {
+        while (m_bytes > m_bytesLimit && m_entries.size() > 1)
+        {
+            auto oldest = std::end(m_entries);
+            for (auto each = std::begin(m_entries); each != std::end(m_entries); ++each)
+            {
+                if (each != keep
+                    && (oldest == std::end(m_entries)
+                        || each->second.lastUse.load(std::memory_order_relaxed) < oldest->second.lastUse.load(std::memory_order_relaxed)))
+                {
+                    oldest = each;
+                }
+            }
+
+            m_bytes -= oldest->second.bytes;
+            m_entries.erase(oldest);
+            ++m_evictions;
+        }
+    }
+
+private:
+    mutable std::shared_timed_mutex m_mutex;
+    Entries m_entries;
+    size_t m_bytes = 0;
+    const size_t m_bytesLimit;
+    size_t m_evictions = 0;
+
+    std::atomic<uint64_t> m_clock{ 0 };
+    std::atomic<size_t> m_hits{ 0 };
+    std::atomic<size_t> m_misses{ 0 };
+};
+
+} // cache
+
+#endif // CACHE_H
@@ -0,0 +1,425 @@
+#include "columnar.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include "logger.h"
+
+// Запись через отображение требует резервирования места (posix_fallocate), недоступного в macOS.
+#if defined(__unix__)
+#define FOURIER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+/**
+ * @brief kMagic - сигнатура файла столбцового формата.
+ */
+const char kMagic[4] = { 'F', 'C', 'O', 'L' };
+
+/**
+ * @brief kFixedHeaderSize, kColumnDescriptorSize - длина постоянной части заголовка и описания столбца (без имени).
+ */
+const size_t kFixedHeaderSize = 24;
+const size_t kColumnDescriptorSize = 16;
+
+/**
+ * @brief kWriteBlockSize - длина блока записи, если отображение файла в память недоступно.
+ */
+const size_t kWriteBlockSize = 1024 * 1024;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+const bool kIsLittleEndian = true;
+#else
+const bool kIsLittleEndian = false;
+#endif
+
+void storeLittleEndian(uint64_t value, const size_t bytes, unsigned char* destination)
+{
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        destination[i] = static_cast<unsigned char>(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+uint64_t loadLittleEndian(const unsigned char* source, const size_t bytes)
+{
+    uint64_t result = 0;
+    for (size_t i = bytes; i > 0; --i)
+    {
+        result = (result << 8) | source[i - 1];
+    }
+    return result;
+}
+
+size_t alignUp(const size_t value)
+{
+    return (value + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+}
+
+size_t typeSize(const ColumnType type)
+{
+    return (type == ColumnType::Float32 ? sizeof(float) : sizeof(double));
+}
+
+/**
+ * @struct Layout
+ * @brief Размещение данных в файле столбцового формата.
+ */
+struct Layout
+{
+    size_t headerSize = 0;
+    std::vector<size_t> offsets; //!< Смещения значений столбцов.
+    size_t fileSize = 0;
+};
+
+Layout makeLayout(const std::vector<std::string>& titles,
+                  const size_t columnsCount,
+                  const size_t rowsCount,
+                  const ColumnType type)
+{
+    Layout result;
+
+    size_t headerSize = kFixedHeaderSize;
+    for (size_t column = 0; column < columnsCount; ++column)
+    {
+        headerSize += kColumnDescriptorSize + (column < titles.size() ? titles[column].size() : 0);
+    }
+    result.headerSize = ::alignUp(headerSize);
+
+    size_t offset = result.headerSize;
+    for (size_t column = 0; column < columnsCount; ++column)
+    {
+        result.offsets.push_back(offset);
+        offset += ::alignUp(rowsCount * ::typeSize(type));
+    }
+    result.fileSize = offset;
+
+    return result;
+}
+
+/**
+ * @brief encodeHeader - записывает заголовок в буфер destination (layout.headerSize байт).
+ */
+void encodeHeader(const std::vector<std::string>& titles,
+                  const size_t rowsCount,
+                  const ColumnType type,
+                  const Layout& layout,
+                  unsigned char* destination)
+{
+    std::fill(destination, destination + layout.headerSize, 0);
+
+    std::memcpy(destination, kMagic, sizeof(kMagic));
+    ::storeLittleEndian(kColumnarVersion, 4, destination + 4);
+    ::storeLittleEndian(rowsCount, 8, destination + 8);
+    ::storeLittleEndian(layout.offsets.size(), 4, destination + 16);
+    ::storeLittleEndian(layout.headerSize, 4, destination + 20);
+
+    unsigned char* descriptor = destination + kFixedHeaderSize;
+    for (size_t column = 0; column < layout.offsets.size(); ++column)
+    {
+        const std::string kName = (column < titles.size() ? titles[column] : std::string());
+        ::storeLittleEndian(layout.offsets[column], 8, descriptor);
+        descriptor[8] = static_cast<unsigned char>(type);
+        ::storeLittleEndian(kName.size(), 4, descriptor + 12);
+        std::memcpy(descriptor + kColumnDescriptorSize, kName.data(), kName.size());
+        descriptor += kColumnDescriptorSize + kName.size();
+    }
+}
+
+/**
+ * @brief encodeValues - записывает значения [first, first + count) столбца column в буфер destination
+ *        (недостающие значения - NaN).
+ */
+void encodeValues(const std::vector<double>& column,
+                  const ColumnType type,
+                  const size_t first,
+                  const size_t count,
+                  unsigned char* destination)
+{
+    const size_t kAvailable = (column.size() > first ? std::min(column.size() - first, count) : 0);
+    const double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+    if (type == ColumnType::Float64)
+    {
+        if (kIsLittleEndian)
+        {
+            std::memcpy(destination, column.data() + first, kAvailable * sizeof(double));
+        }
+        for (size_t i = (kIsLittleEndian ? kAvailable : 0); i < count; ++i)
+        {
+            const double kValue = (i < kAvailable ? column[first + i] : kMissing);
+            uint64_t bits = 0;
+            std::memcpy(&bits, &kValue, sizeof(bits));
+            ::storeLittleEndian(bits, sizeof(bits), destination + i * sizeof(double));
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float kValue = static_cast<float>(i < kAvailable ? column[first + i] : kMissing);
+        uint32_t bits = 0;
+        std::memcpy(&bits, &kValue, sizeof(bits));
+        ::storeLittleEndian(bits, sizeof(bits), destination + i * sizeof(float));
+    }
+}
+
+#ifdef FOURIER_MMAP
+/**
+ * @brief writeMapped - записывает файл через отображение в память; false, если отображение недоступно
+ *        или не удалось зарезервировать место на диске. Место резервируется заранее: при нехватке места
+ *        запись в разреженный файл через отображение завершила бы процесс сигналом SIGBUS вместо ошибки записи.
+ */
+bool writeMapped(const std::string& fileName,
+                 const std::vector<std::string>& titles,
+                 const size_t rowsCount,
+                 const std::vector<std::vector<double>>& columns,
+                 const ColumnType type,
+                 const Layout& layout)
+{
+    const int kFile = ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (kFile < 0)
+    {
+        return false;
+    }
+
+    if (::posix_fallocate(kFile, 0, static_cast<off_t>(layout.fileSize)) != 0)
+    {
+        ::close(kFile);
+        return false;
+    }
+
+    void* const kMapping = ::mmap(nullptr, layout.fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, kFile, 0);
+    ::close(kFile);
+    if (kMapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    unsigned char* const kData = static_cast<unsigned char*>(kMapping);
+    ::encodeHeader(titles, rowsCount, type, layout, kData);
+    for (size_t column = 0; column < columns.size(); ++column)
+    {
+        ::encodeValues(columns[column], type, 0, rowsCount, kData + layout.offsets[column]);
+    }
+
+    ::munmap(kMapping, layout.fileSize);
+    return true;
+}
+#endif
+
+/**
+ * @brief writeBuffered - записывает файл блоками через поток.
+ */
+bool writeBuffered(const std::string& fileName,
+                   const std::vector<std::string>& titles,
+                   const size_t rowsCount,
+                   const std::vector<std::vector<double>>& columns,
+                   const ColumnType type,
+                   const Layout& layout)
+{
+    std::ofstream out(fileName, std::ios::binary);
+    if (!out.good())
+    {
+        return false;
+    }
+
+    std::vector<unsigned char> block(std::max(layout.headerSize, kWriteBlockSize));
+    ::encodeHeader(titles, rowsCount, type, layout, block.data());
+    out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(layout.headerSize));
+
+    const size_t kTypeSize = ::typeSize(type);
+    const size_t kBlockRows = kWriteBlockSize / kTypeSize;
+    for (const std::vector<double>& column : columns)
+    {
+        for (size_t first = 0; first < rowsCount; first += kBlockRows)
+        {
+            const size_t kCount = std::min(kBlockRows, rowsCount - first);
+            ::encodeValues(column, type, first, kCount, block.data());
+            out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(kCount * kTypeSize));
+        }
+
+        const size_t kPadding = ::alignUp(rowsCount * kTypeSize) - rowsCount * kTypeSize;
+        std::fill(block.begin(), block.begin() + kPadding, 0);
+        out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(kPadding));
+    }
+
+    return out.good();
+}
+
+}
+
+bool writeValuesToColumnar(const std::string& fileName,
+                           const std::vector<std::string>& titles,
+                           const size_t linesCount,
+                           const std::vector<std::vector<double>>& columns,
+                           const ColumnType type)
+{
+    const Layout kLayout = ::makeLayout(titles, columns.size(), linesCount, type);
+
+    bool isWritten = false;
+#ifdef FOURIER_MMAP
+    isWritten = ::writeMapped(fileName, titles, linesCount, columns, type, kLayout);
+#endif
+    if (!isWritten)
+    {
+        isWritten = ::writeBuffered(fileName, titles, linesCount, columns, type, kLayout);
+    }
+
+    if (!isWritten)
+    {
+        Logger::error(fileName + ": " + strerror(errno));
+        return false;
+    }
+
+    Logger::info("Writed " + fileName);
+    return true;
+}
+
+void writeValues(const std::string& fileName,
+                 const std::vector<std::string>& titles,
+                 const size_t linesCount,
+                 const std::vector<std::vector<double>>& columns)
+{
+    const std::string kExtension(kColumnarExtension);
+    const bool kIsColumnar = (fileName.size() >= kExtension.size()
+                              && fileName.compare(fileName.size() - kExtension.size(), kExtension.size(), kExtension) == 0);
+    if (kIsColumnar)
+    {
+        writeValuesToColumnar(fileName, titles, linesCount, columns);
+    }
+    else
+    {
+        writeValuesToCsv(fileName, titles, linesCount, columns);
+    }
+}
+
+ColumnarFile::ColumnarFile(const std::string& fileName) :
+    m_file(fileName)
+{
+    if (!kIsLittleEndian)
+    {
+        Logger::error(fileName + ": columnar files can be viewed only on little-endian hosts.");
+        return;
+    }
+
+    m_isOpen = (m_file.isOpen() && parse(fileName));
+    if (!m_isOpen)
+    {
+        m_columns.clear();
+        m_rowsCount = 0;
+    }
+}
+
+const std::string& ColumnarFile::columnName(const size_t column) const
+{
+    return m_columns.at(column).name;
+}
+
+ColumnType ColumnarFile::columnType(const size_t column) const
+{
+    return m_columns.at(column).type;
+}
+
+size_t ColumnarFile::columnIndex(const std::string& name) const
+{
+    const auto kFound = std::find_if(std::begin(m_columns), std::end(m_columns),
+                                     [&name](const Column& each) { return (each.name == name); });
+    return static_cast<size_t>(std::distance(std::begin(m_columns), kFound));
+}
+
+Span<const double> ColumnarFile::float64Column(const size_t column) const
+{
+    const Column& kColumn = m_columns.at(column);
+    if (kColumn.type != ColumnType::Float64)
+    {
+        return Span<const double>();
+    }
+    return Span<const double>(reinterpret_cast<const double*>(kColumn.data), m_rowsCount);
+}
+
+Span<const float> ColumnarFile::float32Column(const size_t column) const
+{
+    const Column& kColumn = m_columns.at(column);
+    if (kColumn.type != ColumnType::Float32)
+    {
+        return Span<const float>();
+    }
+    return Span<const float>(reinterpret_cast<const float*>(kColumn.data), m_rowsCount);
+}
+
+bool ColumnarFile::parse(const std::string& fileName)
+{
+    const unsigned char* const kData = m_file.data();
+    const size_t kSize = m_file.size();
+
+    if (kSize < kFixedHeaderSize || std::memcmp(kData, kMagic, sizeof(kMagic)) != 0)
+    {
+        Logger::error(fileName + ": not a columnar file.");
+        return false;
+    }
+
+    const uint32_t kVersion = static_cast<uint32_t>(::loadLittleEndian(kData + 4, 4));
+    if (kVersion != kColumnarVersion)
+    {
+        Logger::error(fileName + ": unsupported columnar format version " + std::to_string(kVersion) + ".");
+        return false;
+    }
+
+    m_rowsCount = static_cast<size_t>(::loadLittleEndian(kData + 8, 8));
+    const size_t kColumnsCount = static_cast<size_t>(::loadLittleEndian(kData + 16, 4));
+    const size_t kHeaderSize = static_cast<size_t>(::loadLittleEndian(kData + 20, 4));
+    if (kHeaderSize > kSize)
+    {
+        Logger::error(fileName + ": truncated columnar header.");
+        return false;
+    }
+
+    size_t position = kFixedHeaderSize;
+    for (size_t column = 0; column < kColumnsCount; ++column)
+    {
+        if (position + kColumnDescriptorSize > kHeaderSize)
+        {
+            Logger::error(fileName + ": truncated column descriptor.");
+            return false;
+        }
+
+        const unsigned char* const kDescriptor = kData + position;
+        const size_t kOffset = static_cast<size_t>(::loadLittleEndian(kDescriptor, 8));
+        const uint8_t kType = kDescriptor[8];
+        const size_t kNameLength = static_cast<size_t>(::loadLittleEndian(kDescriptor + 12, 4));
+        position += kColumnDescriptorSize + kNameLength;
+
+        if (kType > static_cast<uint8_t>(ColumnType::Float32) || position > kHeaderSize)
+        {
+            Logger::error(fileName + ": invalid column descriptor.");
+            return false;
+        }
+
+        Column each;
+        each.type = static_cast<ColumnType>(kType);
+        each.name.assign(reinterpret_cast<const char*>(kDescriptor + kColumnDescriptorSize), kNameLength);
+
+        const size_t kTypeSize = ::typeSize(each.type);
+        if (kOffset % kTypeSize != 0
+            || kOffset > kSize
+            || m_rowsCount > (kSize - kOffset) / kTypeSize)
+        {
+            Logger::error(fileName + ": column '" + each.name + "' is out of the file bounds.");
+            return false;
+        }
+        each.data = kData + kOffset;
+
+        m_columns.push_back(each);
+    }
+
+    return true;
+}
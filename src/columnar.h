@@ -0,0 +1,134 @@
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mappedfile.h"
+#include "span.h"
+
+/**
+ * Двоичный столбцовый формат файлов значений (расширение kColumnarExtension).
+ * Все числа хранятся в порядке байтов little-endian.
+ *
+ *   Заголовок:
+ *     0: "FCOL"                  - сигнатура;
+ *     4: uint32 version          - версия формата (kColumnarVersion);
+ *     8: uint64 rowsCount        - количество строк (значений в каждом столбце);
+ *    16: uint32 columnsCount     - количество столбцов;
+ *    20: uint32 headerSize       - длина заголовка (смещение данных первого столбца);
+ *    24: описания столбцов:
+ *          uint64 dataOffset     - смещение значений столбца от начала файла (кратно kCacheLineSize);
+ *          uint8  type           - тип значений (ColumnType);
+ *          uint8  reserved[3];
+ *          uint32 nameLength     - длина имени столбца;
+ *          char   name[nameLength].
+ *   Данные: значения каждого столбца - непрерывный массив rowsCount значений, начало которого выровнено по kCacheLineSize.
+ */
+
+/**
+ * @brief kColumnarExtension - расширение имени файла столбцового формата.
+ */
+const char* const kColumnarExtension = ".fcol";
+
+/**
+ * @brief kColumnarVersion - версия столбцового формата.
+ */
+const uint32_t kColumnarVersion = 1;
+
+/**
+ * @brief ColumnType - тип значений столбца.
+ */
+enum class ColumnType : uint8_t
+{
+    Float64 = 0,
+    Float32 = 1
+};
+
+/**
+ * @brief writeValuesToColumnar - записывает значения values в файл столбцового формата с именем fileName.
+ *        Место под файл резервируется, файл отображается в память (POSIX mmap) и заполняется непосредственно;
+ *        если отображение или резервирование места недоступно, данные записываются крупными блоками.
+ *        Недостающие значения коротких столбцов записываются как NaN.
+ * @param fileName - имя выходного файла.
+ * @param titles - список заголовков столбцов данных.
+ * @param linesCount - количество записываемых строк данных.
+ * @param columns - список данных для записи (по столбцам).
+ * @param type - тип хранимых значений.
+ * @return true, если файл записан.
+ */
+bool writeValuesToColumnar(const std::string& fileName,
+                           const std::vector<std::string>& titles,
+                           const size_t linesCount,
+                           const std::vector<std::vector<double>>& columns,
+                           const ColumnType type = ColumnType::Float64);
+
+/**
+ * @brief writeValues - записывает значения в файл fileName в формате, определяемом расширением имени:
+ *        столбцовом (kColumnarExtension) или csv (иначе, см. writeValuesToCsv).
+ */
+void writeValues(const std::string& fileName,
+                 const std::vector<std::string>& titles,
+                 const size_t linesCount,
+                 const std::vector<std::vector<double>>& columns);
+
+/**
+ * @class ColumnarFile
+ * @brief Чтение файла столбцового формата без копирования: файл отображается в память (POSIX mmap,
+ *        иначе считывается в выровненный буфер), столбцы доступны как представления Span над отображением.
+ *
+ * @note Представления столбцов действительны, пока существует экземпляр ColumnarFile.
+ */
+class ColumnarFile
+{
+public:
+    /**
+     * @brief ColumnarFile - открывает файл fileName; при ошибке isOpen() возвращает false (ошибка записывается в лог).
+     */
+    explicit ColumnarFile(const std::string& fileName);
+
+    ColumnarFile(const ColumnarFile&) = delete;
+    ColumnarFile& operator=(const ColumnarFile&) = delete;
+
+    bool isOpen() const { return m_isOpen; }
+
+    size_t rowsCount() const { return m_rowsCount; }
+    size_t columnsCount() const { return m_columns.size(); }
+
+    const std::string& columnName(const size_t column) const;
+    ColumnType columnType(const size_t column) const;
+
+    /**
+     * @brief columnIndex - индекс столбца с именем name (columnsCount(), если такого столбца нет).
+     */
+    size_t columnIndex(const std::string& name) const;
+
+    /**
+     * @brief float64Column, float32Column - значения столбца column соответствующего типа (пустое представление, если тип другой).
+     */
+    Span<const double> float64Column(const size_t column) const;
+    Span<const float> float32Column(const size_t column) const;
+
+private:
+    /**
+     * @struct Column
+     * @brief Описание столбца.
+     */
+    struct Column
+    {
+        std::string name;
+        ColumnType type = ColumnType::Float64;
+        const unsigned char* data = nullptr;
+    };
+
+    bool parse(const std::string& fileName);
+
+private:
+    MappedFile m_file;
+    bool m_isOpen = false;
+    size_t m_rowsCount = 0;
+    std::vector<Column> m_columns;
+};
+
+#endif // COLUMNAR_H
@@ -1,11 +1,147 @@
 #include "commons.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+#include "simd.h"
 
 const double SineBehaviour::kVolumeMin = 0.3;
 const double SineBehaviour::kVolumeMax = 3.0;
 
+bool operator==(const SineBehaviour& left, const SineBehaviour& right)
+{
+    return (left.volumeLevel == right.volumeLevel && left.enabled == right.enabled);
+}
+
+bool operator!=(const SineBehaviour& left, const SineBehaviour& right)
+{
+    return !(left == right);
+}
+
+BehaviourTimeline::BehaviourTimeline(const size_t length,
+                                     const SineBehaviour& behaviour)
+{
+    resize(length, behaviour);
+}
+
+void BehaviourTimeline::resize(const size_t length,
+                               const SineBehaviour& behaviour)
+{
+    if (length < m_size)
+    {
+        const size_t kFirstRemoved = split(length);
+        m_segments.erase(std::begin(m_segments) + kFirstRemoved, std::end(m_segments));
+        m_size = length;
+        return;
+    }
+
+    if (length > m_size)
+    {
+        BehaviourSegment segment;
+        segment.start = m_size;
+        segment.length = length - m_size;
+        segment.behaviour = behaviour;
+        m_segments.push_back(segment);
+        m_size = length;
+        mergeAround(m_segments.size() - 1);
+    }
+}
+
+void BehaviourTimeline::fill(const size_t first,
+                             const size_t last,
+                             const SineBehaviour& behaviour)
+{
+    const size_t kLast = std::min(last, m_size);
+    if (first >= kLast)
+    {
+        return;
+    }
+
+    const size_t kFirstSegment = split(first);
+    const size_t kLastSegment = split(kLast);
+
+    BehaviourSegment& segment = m_segments[kFirstSegment];
+    segment.length = kLast - first;
+    segment.behaviour = behaviour;
+    m_segments.erase(std::begin(m_segments) + kFirstSegment + 1, std::begin(m_segments) + kLastSegment);
+
+    mergeAround(kFirstSegment);
+}
+
+const SineBehaviour& BehaviourTimeline::at(const size_t index) const
+{
+    if (index >= m_size)
+    {
+        throw std::out_of_range("BehaviourTimeline: index " + std::to_string(index)
+                                + " is out of range " + std::to_string(m_size) + ".");
+    }
+    return segmentAt(index)->behaviour;
+}
+
+BehaviourTimeline::const_iterator BehaviourTimeline::segmentAt(const size_t index) const
+{
+    if (index >= m_size)
+    {
+        return end();
+    }
+
+    // Первый отрезок, начинающийся после index; искомый - предшествующий ему.
+    const auto kNext = std::upper_bound(begin(), end(), index,
+                                        [](const size_t value, const BehaviourSegment& segment) { return value < segment.start; });
+    return std::prev(kNext);
+}
+
+size_t BehaviourTimeline::split(const size_t index)
+{
+    assert(index <= m_size);
+    if (index == m_size)
+    {
+        return m_segments.size();
+    }
+
+    const size_t kSegment = static_cast<size_t>(segmentAt(index) - begin());
+    BehaviourSegment& segment = m_segments[kSegment];
+    if (segment.start == index)
+    {
+        return kSegment;
+    }
+
+    BehaviourSegment tail = segment;
+    tail.start = index;
+    tail.length = segment.start + segment.length - index;
+    segment.length = index - segment.start;
+    m_segments.insert(std::begin(m_segments) + kSegment + 1, tail);
+    return kSegment + 1;
+}
+
+void BehaviourTimeline::mergeAround(const size_t index)
+{
+    // Отрезок index только что изменён: объединяется с соседними отрезками того же поведения.
+    size_t lower = index;
+    size_t upper = index + 1;
+    if (lower > 0 && m_segments[lower - 1].behaviour == m_segments[lower].behaviour)
+    {
+        --lower;
+    }
+    if (upper < m_segments.size() && m_segments[upper - 1].behaviour == m_segments[upper].behaviour)
+    {
+        ++upper;
+    }
+    if (upper - lower <= 1)
+    {
+        return;
+    }
+
+    BehaviourSegment& merged = m_segments[lower];
+    const BehaviourSegment& kLastMerged = m_segments[upper - 1];
+    merged.length = kLastMerged.start + kLastMerged.length - merged.start;
+    m_segments.erase(std::begin(m_segments) + lower + 1, std::begin(m_segments) + upper);
+}
+
 double modulus(const std::complex<double>& complex)
 {
     return std::sqrt(sqr(complex.real()) + sqr(complex.imag()));
@@ -16,26 +152,32 @@ double argument(const std::complex<double>& complex)
     return std::atan2(complex.imag(), complex.real());
 }
 
-const std::vector<double> frequencyResponse(const std::vector<std::complex<double>>& spectrum)
+const std::vector<double> frequencyResponse(Span<const std::complex<double>> spectrum)
 {
     std::vector<double> result(spectrum.size());
-    std::transform(std::begin(spectrum),
-                   std::end(spectrum),
-                   std::begin(result),
-                   &modulus);
+    frequencyResponse(spectrum, result);
     return result;
 }
 
-const std::vector<double> phaseResponse(const std::vector<std::complex<double>>& spectrum)
+void frequencyResponse(Span<const std::complex<double>> spectrum, Span<double> response)
+{
+    assert(response.size() >= spectrum.size());
+    simd::magnitude(spectrum.data(), response.data(), spectrum.size());
+}
+
+const std::vector<double> phaseResponse(Span<const std::complex<double>> spectrum)
 {
     std::vector<double> result(spectrum.size());
-    std::transform(std::begin(spectrum),
-                   std::end(spectrum),
-                   std::begin(result),
-                   &argument);
+    phaseResponse(spectrum, result);
     return result;
 }
 
+void phaseResponse(Span<const std::complex<double>> spectrum, Span<double> response)
+{
+    assert(response.size() >= spectrum.size());
+    simd::phase(spectrum.data(), response.data(), spectrum.size());
+}
+
 size_t frequencyToIndex(const double frequency, const size_t width)
 {
     return std::round(width / (2.0 * M_PI * frequency));
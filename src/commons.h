@@ -4,6 +4,8 @@
 #include <complex>
 #include <vector>
 
+#include "span.h"
+
 /**
  * @brief unused - служебная пометка для неиспользуемых переменных.
  */
@@ -37,17 +39,33 @@ double argument(const std::complex<double>& complex);
 
 /**
  * @brief frequencyResponse - вычисление модуля спектра (амплитудно-частотная характеристика (АЧХ) сигнала).
+ * @param spectrum - спектр сигнала: полный или его неотрицательная половина (см. fourier::realDft).
+ * @return значения амплитуды сигнала в зависимости от частоты (по одному на каждый отсчёт spectrum).
+ */
+const std::vector<double> frequencyResponse(Span<const std::complex<double>> spectrum);
+
+/**
+ * @brief frequencyResponse - вычисление модуля спектра spectrum с записью в буфер response, предоставленный вызывающей стороной.
  * @param spectrum - спектр сигнала.
- * @return значения амплитуды сигнала в зависимости от частоты.
+ * @param response - значения амплитуды (не менее spectrum.size() отсчётов).
  */
-const std::vector<double> frequencyResponse(const std::vector<std::complex<double>>& spectrum);
+void frequencyResponse(Span<const std::complex<double>> spectrum, Span<double> response);
 
 /**
  * @brief phaseResponse - вычисление аргумента спектра (фазово-частотная характеристика (ФЧХ) сигнала).
+ *        Аргумент вычисляется векторизованным приближением (см. simd::phase), отличающимся от argument
+ *        не более чем на simd::kPhaseMaxError радиан.
+ * @param spectrum - спектр сигнала: полный или его неотрицательная половина (см. fourier::realDft).
+ * @return значения фазы сигнала в зависимости от частоты (по одному на каждый отсчёт spectrum).
+ */
+const std::vector<double> phaseResponse(Span<const std::complex<double>> spectrum);
+
+/**
+ * @brief phaseResponse - вычисление аргумента спектра spectrum с записью в буфер response, предоставленный вызывающей стороной.
  * @param spectrum - спектр сигнала.
- * @return значения фазы сигнала в зависимости от частоты.
+ * @param response - значения фазы (не менее spectrum.size() отсчётов).
  */
-const std::vector<double> phaseResponse(const std::vector<std::complex<double>>& spectrum);
+void phaseResponse(Span<const std::complex<double>> spectrum, Span<double> response);
 
 /**
  * @brief frequencyToIndex - преобразует множитель частоты frequency в индекс спектра ширины length.
@@ -87,6 +105,85 @@ struct SineBehaviour
     bool   enabled = false;          //!< Включен ли сигнал.
 };
 
+bool operator==(const SineBehaviour& left, const SineBehaviour& right);
+bool operator!=(const SineBehaviour& left, const SineBehaviour& right);
+
+/**
+ * @struct BehaviourSegment
+ * @brief Отрезок отсчётов [start, start + length) с неизменным поведением базового сигнала.
+ */
+struct BehaviourSegment
+{
+    size_t start = 0;        //!< Индекс первого отсчёта отрезка.
+    size_t length = 0;       //!< Количество отсчётов отрезка.
+    SineBehaviour behaviour; //!< Поведение базового сигнала на отрезке.
+};
+
+/**
+ * @class BehaviourTimeline
+ * @brief Поведение базового сигнала во времени, хранящееся отрезками с неизменным поведением (кодирование длин серий).
+ *        Отрезки следуют друг за другом без промежутков, начиная с отсчёта 0; соседние отрезки с одинаковым
+ *        поведением объединяются. Объём памяти пропорционален количеству изменений поведения, а не длине сигнала.
+ */
+class BehaviourTimeline
+{
+public:
+    using const_iterator = std::vector<BehaviourSegment>::const_iterator;
+
+    BehaviourTimeline() = default;
+
+    /**
+     * @brief BehaviourTimeline - создаёт поведение длиной length отсчётов, неизменное на всём протяжении.
+     */
+    explicit BehaviourTimeline(const size_t length,
+                               const SineBehaviour& behaviour = SineBehaviour());
+
+    /**
+     * @brief size - количество отсчётов.
+     */
+    size_t size() const { return m_size; }
+    bool empty() const { return (m_size == 0); }
+
+    /**
+     * @brief resize - изменяет количество отсчётов; добавленные отсчёты получают поведение behaviour.
+     */
+    void resize(const size_t length,
+                const SineBehaviour& behaviour = SineBehaviour());
+
+    /**
+     * @brief fill - задаёт поведение behaviour отсчётам [first, last) (не далее size()).
+     */
+    void fill(const size_t first,
+              const size_t last,
+              const SineBehaviour& behaviour);
+
+    /**
+     * @brief at - поведение в отсчёте index (двоичный поиск отрезка, O(log k) для k отрезков).
+     * @throw std::out_of_range, если index не меньше size().
+     */
+    const SineBehaviour& at(const size_t index) const;
+
+    /**
+     * @brief segmentAt - итератор отрезка, содержащего отсчёт index (end(), если index не меньше size()).
+     */
+    const_iterator segmentAt(const size_t index) const;
+
+    /**
+     * @brief begin, end - отрезки с неизменным поведением в порядке следования.
+     */
+    const_iterator begin() const { return std::begin(m_segments); }
+    const_iterator end() const { return std::end(m_segments); }
+    size_t segmentsCount() const { return m_segments.size(); }
+
+private:
+    size_t split(const size_t index);
+    void mergeAround(const size_t index);
+
+private:
+    std::vector<BehaviourSegment> m_segments;
+    size_t m_size = 0;
+};
+
 /**
  * @struct SineSignal
  * @brief Параметры базового сигнала.
@@ -94,7 +191,7 @@ struct SineBehaviour
 struct SineSignal
 {
     SineOption sine;                      //!< Характеристики синусоиды базового сигнала.
-    std::vector<SineBehaviour> behaviour; //!< Поведение базового сигнала во времени.
+    BehaviourTimeline behaviour;          //!< Поведение базового сигнала во времени.
 };
 
 #endif // COMMONS_H
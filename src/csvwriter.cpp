@@ -0,0 +1,596 @@
+#include "csvwriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+/**
+ * @brief kRowsBlock - количество строк, значения которых записываются по всем столбцам перед переходом к следующим строкам.
+ */
+const size_t kRowsBlock = 256;
+
+/**
+ * @brief kMaxQueuedBlocks - наибольшее количество блоков, ожидающих записи в фоновом потоке
+ *        (при заполнении очереди форматирование ожидает записи).
+ */
+const size_t kMaxQueuedBlocks = 4;
+
+const char kSeparator[] = ", ";
+
+/**
+ * Кратчайшее представление значений double - алгоритм Grisu2 (F. Loitsch, "Printing Floating-Point Numbers
+ * Quickly and Accurately with Integers", 2010): цифры генерируются целочисленной арифметикой внутри интервала,
+ * все значения которого округляются к исходному, поэтому представление всегда восстанавливает значение точно
+ * и почти всегда является кратчайшим (в редких случаях на одну цифру длиннее).
+ */
+
+/**
+ * @struct DiyFp
+ * @brief Значение f * 2^e с 64-битной мантиссой.
+ */
+struct DiyFp
+{
+    uint64_t f = 0;
+    int e = 0;
+
+    DiyFp() = default;
+    DiyFp(const uint64_t significand, const int exponent) :
+        f(significand),
+        e(exponent)
+    { }
+};
+
+DiyFp subtract(const DiyFp& x, const DiyFp& y)
+{
+    return DiyFp(x.f - y.f, x.e);
+}
+
+/**
+ * @brief multiply - старшие 64 бита произведения мантисс (с округлением).
+ */
+DiyFp multiply(const DiyFp& x, const DiyFp& y)
+{
+    const uint64_t kLowMask = 0xFFFFFFFFULL;
+    const uint64_t p0 = (x.f & kLowMask) * (y.f & kLowMask);
+    const uint64_t p1 = (x.f & kLowMask) * (y.f >> 32);
+    const uint64_t p2 = (x.f >> 32) * (y.f & kLowMask);
+    const uint64_t p3 = (x.f >> 32) * (y.f >> 32);
+
+    uint64_t middle = (p0 >> 32) + (p1 & kLowMask) + (p2 & kLowMask);
+    middle += 1ULL << 31;
+
+    return DiyFp(p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32), x.e + y.e + 64);
+}
+
+DiyFp normalize(DiyFp x)
+{
+    while ((x.f >> 63) == 0)
+    {
+        x.f <<= 1;
+        --x.e;
+    }
+    return x;
+}
+
+/**
+ * @struct Boundaries
+ * @brief Значение v и границы интервала значений, округляемых к v (m-, m+), с общим показателем m+.
+ */
+struct Boundaries
+{
+    DiyFp w;
+    DiyFp minus;
+    DiyFp plus;
+};
+
+Boundaries computeBoundaries(const double value)
+{
+    const int kBias = 1023 + 52;
+    const int kMinExponent = 1 - kBias;
+    const uint64_t kHiddenBit = 1ULL << 52;
+
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint64_t kExponentBits = (bits >> 52) & 0x7FF;
+    const uint64_t kFraction = bits & (kHiddenBit - 1);
+
+    const DiyFp v = (kExponentBits == 0 ? DiyFp(kFraction, kMinExponent)
+                                        : DiyFp(kFraction + kHiddenBit, static_cast<int>(kExponentBits) - kBias));
+
+    // Нижняя граница ближе к значению, если мантисса - наименьшая для своего показателя.
+    const bool kIsLowerCloser = (kFraction == 0 && kExponentBits > 1);
+    const DiyFp plus(2 * v.f + 1, v.e - 1);
+    const DiyFp minus = (kIsLowerCloser ? DiyFp(4 * v.f - 1, v.e - 2)
+                                        : DiyFp(2 * v.f - 1, v.e - 1));
+
+    Boundaries result;
+    result.plus = ::normalize(plus);
+    result.minus = DiyFp(minus.f << (minus.e - result.plus.e), result.plus.e);
+    result.w = ::normalize(v);
+    return result;
+}
+
+/**
+ * @struct CachedPower
+ * @brief Приближение 10^k = f * 2^e.
+ */
+struct CachedPower
+{
+    uint64_t f;
+    int e;
+    int k;
+};
+
+const CachedPower kCachedPowers[] =
+{
+    { 0xAB70FE17C79AC6CAULL, -1060, -300 },
+    { 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+    { 0xBE5691EF416BD60CULL, -1007, -284 },
+    { 0x8DD01FAD907FFC3CULL,  -980, -276 },
+    { 0xD3515C2831559A83ULL,  -954, -268 },
+    { 0x9D71AC8FADA6C9B5ULL,  -927, -260 },
+    { 0xEA9C227723EE8BCBULL,  -901, -252 },
+    { 0xAECC49914078536DULL,  -874, -244 },
+    { 0x823C12795DB6CE57ULL,  -847, -236 },
+    { 0xC21094364DFB5637ULL,  -821, -228 },
+    { 0x9096EA6F3848984FULL,  -794, -220 },
+    { 0xD77485CB25823AC7ULL,  -768, -212 },
+    { 0xA086CFCD97BF97F4ULL,  -741, -204 },
+    { 0xEF340A98172AACE5ULL,  -715, -196 },
+    { 0xB23867FB2A35B28EULL,  -688, -188 },
+    { 0x84C8D4DFD2C63F3BULL,  -661, -180 },
+    { 0xC5DD44271AD3CDBAULL,  -635, -172 },
+    { 0x936B9FCEBB25C996ULL,  -608, -164 },
+    { 0xDBAC6C247D62A584ULL,  -582, -156 },
+    { 0xA3AB66580D5FDAF6ULL,  -555, -148 },
+    { 0xF3E2F893DEC3F126ULL,  -529, -140 },
+    { 0xB5B5ADA8AAFF80B8ULL,  -502, -132 },
+    { 0x87625F056C7C4A8BULL,  -475, -124 },
+    { 0xC9BCFF6034C13053ULL,  -449, -116 },
+    { 0x964E858C91BA2655ULL,  -422, -108 },
+    { 0xDFF9772470297EBDULL,  -396, -100 },
+    { 0xA6DFBD9FB8E5B88FULL,  -369,  -92 },
+    { 0xF8A95FCF88747D94ULL,  -343,  -84 },
+    { 0xB94470938FA89BCFULL,  -316,  -76 },
+    { 0x8A08F0F8BF0F156BULL,  -289,  -68 },
+    { 0xCDB02555653131B6ULL,  -263,  -60 },
+    { 0x993FE2C6D07B7FACULL,  -236,  -52 },
+    { 0xE45C10C42A2B3B06ULL,  -210,  -44 },
+    { 0xAA242499697392D3ULL,  -183,  -36 },
+    { 0xFD87B5F28300CA0EULL,  -157,  -28 },
+    { 0xBCE5086492111AEBULL,  -130,  -20 },
+    { 0x8CBCCC096F5088CCULL,  -103,  -12 },
+    { 0xD1B71758E219652CULL,   -77,   -4 },
+    { 0x9C40000000000000ULL,   -50,    4 },
+    { 0xE8D4A51000000000ULL,   -24,   12 },
+    { 0xAD78EBC5AC620000ULL,     3,   20 },
+    { 0x813F3978F8940984ULL,    30,   28 },
+    { 0xC097CE7BC90715B3ULL,    56,   36 },
+    { 0x8F7E32CE7BEA5C70ULL,    83,   44 },
+    { 0xD5D238A4ABE98068ULL,   109,   52 },
+    { 0x9F4F2726179A2245ULL,   136,   60 },
+    { 0xED63A231D4C4FB27ULL,   162,   68 },
+    { 0xB0DE65388CC8ADA8ULL,   189,   76 },
+    { 0x83C7088E1AAB65DBULL,   216,   84 },
+    { 0xC45D1DF942711D9AULL,   242,   92 },
+    { 0x924D692CA61BE758ULL,   269,  100 },
+    { 0xDA01EE641A708DEAULL,   295,  108 },
+    { 0xA26DA3999AEF774AULL,   322,  116 },
+    { 0xF209787BB47D6B85ULL,   348,  124 },
+    { 0xB454E4A179DD1877ULL,   375,  132 },
+    { 0x865B86925B9BC5C2ULL,   402,  140 },
+    { 0xC83553C5C8965D3DULL,   428,  148 },
+    { 0x952AB45CFA97A0B3ULL,   455,  156 },
+    { 0xDE469FBD99A05FE3ULL,   481,  164 },
+    { 0xA59BC234DB398C25ULL,   508,  172 },
+    { 0xF6C69A72A3989F5CULL,   534,  180 },
+    { 0xB7DCBF5354E9BECEULL,   561,  188 },
+    { 0x88FCF317F22241E2ULL,   588,  196 },
+    { 0xCC20CE9BD35C78A5ULL,   614,  204 },
+    { 0x98165AF37B2153DFULL,   641,  212 },
+    { 0xE2A0B5DC971F303AULL,   667,  220 },
+    { 0xA8D9D1535CE3B396ULL,   694,  228 },
+    { 0xFB9B7CD9A4A7443CULL,   720,  236 },
+    { 0xBB764C4CA7A44410ULL,   747,  244 },
+    { 0x8BAB8EEFB6409C1AULL,   774,  252 },
+    { 0xD01FEF10A657842CULL,   800,  260 },
+    { 0x9B10A4E5E9913129ULL,   827,  268 },
+    { 0xE7109BFBA19C0C9DULL,   853,  276 },
+    { 0xAC2820D9623BF429ULL,   880,  284 },
+    { 0x80444B5E7AA7CF85ULL,   907,  292 },
+    { 0xBF21E44003ACDD2DULL,   933,  300 },
+    { 0x8E679C2F5E44FF8FULL,   960,  308 },
+    { 0xD433179D9C8CB841ULL,   986,  316 },
+    { 0x9E19DB92B4E31BA9ULL,  1013,  324 }
+};
+
+const int kCachedPowersMinDecimalExponent = -300;
+const int kCachedPowersDecimalStep = 8;
+
+/**
+ * @brief kAlpha - нижняя граница диапазона [-60, -32] двоичного показателя произведения на степень 10,
+ *        в котором цифры генерируются 64-битной арифметикой (шаг таблицы kCachedPowers - 8 десятичных порядков).
+ */
+const int kAlpha = -60;
+
+/**
+ * @brief cachedPowerForBinaryExponent - степень 10, приводящая показатель e к диапазону [kAlpha, kAlpha + 28].
+ */
+const CachedPower& cachedPowerForBinaryExponent(const int e)
+{
+    // k = ceil((kAlpha - e - 1) * log10(2)); 78913 / 2^18 ~ log10(2).
+    const int f = kAlpha - e - 1;
+    const int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+    const int index = (-kCachedPowersMinDecimalExponent + k + (kCachedPowersDecimalStep - 1)) / kCachedPowersDecimalStep;
+    return kCachedPowers[index];
+}
+
+/**
+ * @brief largestPowerOf10 - количество десятичных цифр значения n (не менее 1) и наибольшая степень 10, не превышающая n.
+ */
+int largestPowerOf10(const uint32_t n, uint32_t& power)
+{
+    int digits = 10;
+    power = 1000000000;
+    while (digits > 1 && n < power)
+    {
+        power /= 10;
+        --digits;
+    }
+    return digits;
+}
+
+/**
+ * @brief roundLastDigit - приближает последнюю цифру к значению w, пока результат остаётся внутри интервала.
+ */
+void roundLastDigit(char* buffer, const int length, const uint64_t distance, const uint64_t delta, uint64_t rest, const uint64_t tenK)
+{
+    while (rest < distance
+           && delta - rest >= tenK
+           && (rest + tenK < distance || distance - rest > rest + tenK - distance))
+    {
+        --buffer[length - 1];
+        rest += tenK;
+    }
+}
+
+/**
+ * @brief generateDigits - цифры кратчайшего числа внутри интервала (minus, plus): value = digits * 10^decimalExponent.
+ */
+void generateDigits(char* buffer, int& length, int& decimalExponent, const DiyFp& minus, const DiyFp& w, const DiyFp& plus)
+{
+    uint64_t delta = ::subtract(plus, minus).f;
+    uint64_t distance = ::subtract(plus, w).f;
+
+    const DiyFp one(1ULL << -plus.e, plus.e);
+    uint32_t integral = static_cast<uint32_t>(plus.f >> -one.e);
+    uint64_t fractional = plus.f & (one.f - 1);
+
+    uint32_t power = 0;
+    int n = ::largestPowerOf10(integral, power);
+    while (n > 0)
+    {
+        buffer[length++] = static_cast<char>('0' + integral / power);
+        integral %= power;
+        --n;
+
+        const uint64_t kRest = (static_cast<uint64_t>(integral) << -one.e) + fractional;
+        if (kRest <= delta)
+        {
+            decimalExponent += n;
+            ::roundLastDigit(buffer, length, distance, delta, kRest, static_cast<uint64_t>(power) << -one.e);
+            return;
+        }
+        power /= 10;
+    }
+
+    int m = 0;
+    while (true)
+    {
+        fractional *= 10;
+        buffer[length++] = static_cast<char>('0' + (fractional >> -one.e));
+        fractional &= one.f - 1;
+        ++m;
+
+        delta *= 10;
+        distance *= 10;
+        if (fractional <= delta)
+        {
+            break;
+        }
+    }
+
+    decimalExponent -= m;
+    ::roundLastDigit(buffer, length, distance, delta, fractional, one.f);
+}
+
+/**
+ * @brief grisu2 - цифры (buffer, length) и десятичный показатель кратчайшего представления положительного конечного value.
+ */
+void grisu2(char* buffer, int& length, int& decimalExponent, const double value)
+{
+    const Boundaries kBoundaries = ::computeBoundaries(value);
+    const CachedPower& kCached = ::cachedPowerForBinaryExponent(kBoundaries.plus.e);
+    const DiyFp kPower(kCached.f, kCached.e);
+
+    const DiyFp w = ::multiply(kBoundaries.w, kPower);
+    const DiyFp minus = ::multiply(kBoundaries.minus, kPower);
+    const DiyFp plus = ::multiply(kBoundaries.plus, kPower);
+
+    // Интервал сужается на единицу младшего разряда с каждой стороны, компенсируя погрешность умножения.
+    length = 0;
+    decimalExponent = -kCached.k;
+    ::generateDigits(buffer, length, decimalExponent, DiyFp(minus.f + 1, minus.e), w, DiyFp(plus.f - 1, plus.e));
+}
+
+/**
+ * @brief formatDigits - записывает цифры digits[0, length) * 10^decimalExponent в обычной или экспоненциальной форме (как %g).
+ */
+size_t formatDigits(const char* digits, const int length, const int decimalExponent, char* buffer)
+{
+    const int kMinFixedExponent = -4;
+    const int kMaxFixedExponent = 17;
+
+    // Положение десятичной точки относительно первой цифры.
+    const int n = length + decimalExponent;
+    char* out = buffer;
+
+    if (length <= n && n <= kMaxFixedExponent)
+    {
+        // Целое число: цифры и нули.
+        out = std::copy(digits, digits + length, out);
+        out = std::fill_n(out, n - length, '0');
+    }
+    else if (0 < n && n <= kMaxFixedExponent)
+    {
+        out = std::copy(digits, digits + n, out);
+        *out++ = '.';
+        out = std::copy(digits + n, digits + length, out);
+    }
+    else if (kMinFixedExponent < n && n <= 0)
+    {
+        *out++ = '0';
+        *out++ = '.';
+        out = std::fill_n(out, -n, '0');
+        out = std::copy(digits, digits + length, out);
+    }
+    else
+    {
+        *out++ = digits[0];
+        if (length > 1)
+        {
+            *out++ = '.';
+            out = std::copy(digits + 1, digits + length, out);
+        }
+
+        int exponent = n - 1;
+        *out++ = 'e';
+        *out++ = (exponent < 0 ? '-' : '+');
+        exponent = std::abs(exponent);
+        if (exponent >= 100)
+        {
+            *out++ = static_cast<char>('0' + exponent / 100);
+            exponent %= 100;
+        }
+        *out++ = static_cast<char>('0' + exponent / 10);
+        *out++ = static_cast<char>('0' + exponent % 10);
+    }
+
+    return static_cast<size_t>(out - buffer);
+}
+
+}
+
+size_t formatDouble(const double value, char* buffer)
+{
+    if (std::isnan(value))
+    {
+        std::memcpy(buffer, "nan", 4);
+        return 3;
+    }
+
+    size_t length = 0;
+    if (std::signbit(value))
+    {
+        buffer[length++] = '-';
+    }
+
+    const double kMagnitude = std::abs(value);
+    if (std::isinf(kMagnitude))
+    {
+        std::memcpy(buffer + length, "inf", 4);
+        return length + 3;
+    }
+    if (kMagnitude == 0.0)
+    {
+        buffer[length++] = '0';
+        buffer[length] = '\0';
+        return length;
+    }
+
+    char digits[kFormattedDoubleMaxLength];
+    int digitsCount = 0;
+    int decimalExponent = 0;
+    ::grisu2(digits, digitsCount, decimalExponent, kMagnitude);
+
+    length += ::formatDigits(digits, digitsCount, decimalExponent, buffer + length);
+    buffer[length] = '\0';
+    return length;
+}
+
+CsvWriter::CsvWriter(const std::string& fileName,
+                     const CsvWriterOptions& options) :
+    m_options(options),
+    m_out(fileName, std::ios::binary)
+{
+    m_options.bufferSize = std::max<size_t>(m_options.bufferSize, kFormattedDoubleMaxLength);
+    m_buffer.reserve(m_options.bufferSize);
+    m_isFailed = !m_out.good();
+
+    if (m_options.isBackground && !m_isFailed)
+    {
+        m_writer = std::thread(&CsvWriter::writerLoop, this);
+    }
+}
+
+CsvWriter::~CsvWriter()
+{
+    flush();
+
+    if (m_writer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopping = true;
+        }
+        m_changed.notify_all();
+        m_writer.join();
+    }
+}
+
+bool CsvWriter::good() const
+{
+    return !m_isFailed;
+}
+
+void CsvWriter::writeRow(const std::vector<std::string>& cells)
+{
+    bool isFirstColumn = true;
+    for (const std::string& each : cells)
+    {
+        if (!isFirstColumn)
+            append(kSeparator, sizeof(kSeparator) - 1);
+        else
+            isFirstColumn = false;
+
+        append(each.data(), each.size());
+    }
+    append("\n", 1);
+}
+
+void CsvWriter::writeColumns(const std::vector<std::vector<double>>& columns,
+                             const size_t first,
+                             const size_t count)
+{
+    char formatted[kFormattedDoubleMaxLength];
+
+    const size_t kLast = first + count;
+    for (size_t blockFirst = first; blockFirst < kLast; blockFirst += kRowsBlock)
+    {
+        const size_t kBlockLast = std::min(blockFirst + kRowsBlock, kLast);
+        for (size_t row = blockFirst; row < kBlockLast; ++row)
+        {
+            bool isFirstColumn = true;
+            for (const std::vector<double>& eachColumn : columns)
+            {
+                if (!isFirstColumn)
+                    append(kSeparator, sizeof(kSeparator) - 1);
+                else
+                    isFirstColumn = false;
+
+                if (row < eachColumn.size())
+                {
+                    append(formatted, formatDouble(eachColumn[row], formatted));
+                }
+            }
+            append("\n", 1);
+        }
+    }
+}
+
+void CsvWriter::flush()
+{
+    commit();
+
+    if (m_writer.joinable())
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this]() { return (m_queue.empty() && !m_isWriting); });
+    }
+
+    m_out.flush();
+    if (!m_out.good())
+    {
+        m_isFailed = true;
+    }
+}
+
+void CsvWriter::append(const char* data, const size_t length)
+{
+    if (m_buffer.size() + length > m_options.bufferSize)
+    {
+        commit();
+    }
+    m_buffer.append(data, length);
+}
+
+void CsvWriter::commit()
+{
+    if (m_buffer.empty())
+    {
+        return;
+    }
+
+    if (!m_writer.joinable())
+    {
+        write(m_buffer);
+        m_buffer.clear();
+        return;
+    }
+
+    std::string next;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this]() { return (m_queue.size() < kMaxQueuedBlocks); });
+
+        m_queue.push_back(std::move(m_buffer));
+        if (!m_free.empty())
+        {
+            next = std::move(m_free.back());
+            m_free.pop_back();
+        }
+    }
+    m_changed.notify_all();
+
+    next.clear();
+    next.reserve(m_options.bufferSize);
+    m_buffer = std::move(next);
+}
+
+void CsvWriter::write(const std::string& block)
+{
+    m_out.write(block.data(), static_cast<std::streamsize>(block.size()));
+    if (!m_out.good())
+    {
+        m_isFailed = true;
+    }
+}
+
+void CsvWriter::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_changed.wait(lock, [this]() { return (!m_queue.empty() || m_isStopping); });
+        if (m_queue.empty())
+        {
+            break;
+        }
+
+        std::string block = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_isWriting = true;
+
+        lock.unlock();
+        write(block);
+        lock.lock();
+
+        m_isWriting = false;
+        m_free.push_back(std::move(block));
+        m_changed.notify_all();
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef CSVWRITER_H
+#define CSVWRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief formatDouble - записывает в буфер buffer кратчайшее десятичное представление значения value,
+ *        из которого value восстанавливается точно (не более 17 значащих цифр, алгоритм Grisu2; в редких случаях
+ *        представление на одну цифру длиннее кратчайшего). Не зависит от локали. Формат - как у %g:
+ *        экспоненциальная форма для очень больших и очень малых значений; "nan", "inf", "-inf".
+ * @param value - значение.
+ * @param buffer - буфер не короче kFormattedDoubleMaxLength символов.
+ * @return длина представления (без завершающего нуля).
+ */
+size_t formatDouble(const double value, char* buffer);
+
+/**
+ * @brief kFormattedDoubleMaxLength - наибольшая длина представления formatDouble (включая завершающий нуль).
+ */
+const size_t kFormattedDoubleMaxLength = 32;
+
+/**
+ * @struct CsvWriterOptions
+ * @brief Параметры записи csv-файла.
+ */
+struct CsvWriterOptions
+{
+    size_t bufferSize = 1024 * 1024; //!< Размер блока форматированных данных, передаваемого на запись.
+    bool isBackground = false;       //!< Записывать ли блоки в фоновом потоке (форматирование и запись на диск выполняются одновременно).
+};
+
+/**
+ * @class CsvWriter
+ * @brief Запись csv-файла крупными блоками: значения форматируются в буфер, который записывается в файл
+ *        по заполнении (в вызывающем или фоновом потоке) и при явном вызове flush.
+ *        Значения столбцов обходятся блоками строк, так что обрабатываемые части всех столбцов находятся в кэше.
+ *
+ * @note Методы экземпляра вызываются из одного потока; фоновый поток только записывает готовые блоки.
+ */
+class CsvWriter
+{
+public:
+    explicit CsvWriter(const std::string& fileName,
+                       const CsvWriterOptions& options = CsvWriterOptions());
+
+    /**
+     * @brief ~CsvWriter - записывает оставшиеся данные и завершает фоновый поток.
+     */
+    ~CsvWriter();
+
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+
+    /**
+     * @brief good - открыт ли файл и успешны ли все выполненные записи.
+     */
+    bool good() const;
+
+    /**
+     * @brief writeRow - добавляет строку из текстовых значений cells (например, заголовки столбцов).
+     */
+    void writeRow(const std::vector<std::string>& cells);
+
+    /**
+     * @brief writeColumns - добавляет строки [first, first + count) значений столбцов columns
+     *        (для отсутствующих в коротком столбце строк значение не записывается).
+     */
+    void writeColumns(const std::vector<std::vector<double>>& columns,
+                      const size_t first,
+                      const size_t count);
+
+    /**
+     * @brief flush - записывает все добавленные данные в файл.
+     */
+    void flush();
+
+private:
+    void append(const char* data, const size_t length);
+    void commit();
+    void write(const std::string& block);
+    void writerLoop();
+
+private:
+    CsvWriterOptions m_options;
+    std::ofstream m_out;
+    std::string m_buffer;                 //!< Заполняемый блок.
+    std::atomic<bool> m_isFailed{ false };
+
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::deque<std::string> m_queue;      //!< Блоки, ожидающие записи в фоновом потоке.
+    std::vector<std::string> m_free;      //!< Записанные блоки, память которых используется повторно.
+    bool m_isWriting = false;
+    bool m_isStopping = false;
+    std::thread m_writer;
+};
+
+#endif // CSVWRITER_H
@@ -2,12 +2,16 @@
 
 #include <algorithm>
 #include <cassert>
-#include <numeric>
+#include <cmath>
+#include <utility>
 
+#include "columnar.h"
 #include "commons.h"
-#include "dft.h"
 #include "filter.h"
 #include "logger.h"
+#include "segmentdetector.h"
+#include "smooth.h"
+#include "threadpool.h"
 #include "wave.h"
 
 namespace
@@ -15,231 +19,231 @@ namespace
 
 struct WindowBounds
 {
-    std::vector<double>::const_iterator lower;
-    std::vector<double>::const_iterator upper;
+    const double* lower = nullptr;
+    const double* upper = nullptr;
 
     WindowBounds() = default;
-    WindowBounds(const std::vector<double>::const_iterator& first,
-                 const std::vector<double>::const_iterator& last) :
+    WindowBounds(const double* first,
+                 const double* last) :
         lower(first),
         upper(last)
     { }
 };
 
 /**
- * @brief splitToWindows - разделяет входную последовательность signal на окна длиной windowWidth.
- *        Каждое следующее окно смещается относительно предыдущего на значение offset (окна могут перекрываться).
- * @param signal - разделяемая последовательность значений.
- * @param windowWidth - ширина окна.
- * @param offset - смещение следующего окна от предыдущего.
- * @return набор окон.
+ * @class SlidingWindows
+ * @brief Набор окон шириной width, каждое следующее из которых смещено относительно предыдущего на hop отсчётов.
+ *        Границы окон вычисляются при обращении, без построения вектора всех окон.
+ *        Последнее положение окна, доходящее до конца сигнала, не включается; сигнал не длиннее окна даёт одно окно.
  */
-std::vector<WindowBounds> splitToWindows(const std::vector<double>& signal,
-                                         const size_t windowWidth,
-                                         const size_t offset = 1)
+class SlidingWindows
 {
-    std::vector<WindowBounds> result;
+public:
+    SlidingWindows(Span<const double> signal,
+                   const size_t width,
+                   const size_t hop = 1) :
+        m_signal(signal),
+        m_width(width),
+        m_hop(hop)
+    {
+        assert(m_hop > 0);
+    }
 
-    if (signal.size() > windowWidth)
+    /**
+     * @brief size - количество окон.
+     */
+    size_t size() const
     {
-        result.reserve(signal.size()- windowWidth + 1);
+        return (m_signal.size() > m_width ? (m_signal.size() - m_width + m_hop - 1) / m_hop : 1);
+    }
 
-        auto it = signal.cbegin() + windowWidth,
-             end = signal.cend();
-        while (it != end)
+    /**
+     * @brief operator[] - границы окна с номером index.
+     */
+    WindowBounds operator[](const size_t index) const
+    {
+        assert(index < size());
+        if (m_signal.size() <= m_width)
         {
-            result.emplace_back((it - windowWidth), it);
-            if (std::distance(it, end) >= static_cast<int>(offset))
-            {
-                it += offset;
-            }
-            else
-            {
-                result.emplace_back(it, end);
-                break;
-            }
+            return WindowBounds(std::begin(m_signal), std::end(m_signal));
         }
-    }
-    else
-    {
-        result.emplace_back(signal.cbegin(), signal.cend());
+
+        const double* const kLower = std::begin(m_signal) + index * m_hop;
+        return WindowBounds(kLower, kLower + m_width);
     }
 
-    return result;
-}
+private:
+    Span<const double> m_signal;
+    size_t m_width = 0;
+    size_t m_hop = 1;
+};
 
 /**
- * @brief splitByThreshold - выделяет из входной последовательности signal окна,
- *        в которых все значения выше порогового значения threshold.
- * @param signal - анализируемая последовательность.
- * @param threshold - пороговое значение.
- * @return набор окон.
+ * @brief decomposeByProbabilites - выделяет из временного распределения вероятности обнаружения базового сигнала в сложном
+ *        структуры с параметрами, характеризующими обнаруженный базовый сигнал.
+ * @param probabilities - временное распределение вероятности обнаружения сигнала с частотой frequency в сложном сигнале.
+ * @param frequency - частота базового сигнала.
+ * @param hop - шаг положений окна (в отсчётах сигнала), соответствующий одному значению probabilities.
+ * @return набор структур Wave, характеризующих наличие базового сигнала с частотой frequency в составе сложного сигнала
+ *         (индексы и длительности - в отсчётах сигнала).
  */
-std::vector<WindowBounds> splitByThreshold(const std::vector<double>& signal,
-                                           const double threshold)
+WaveDecomposition decomposeByProbabilites(Span<const double> probabilities,
+                                          const double frequency,
+                                          const size_t hop)
 {
-    std::vector<WindowBounds> result;
+    const size_t kMinimumDuration = kMinimumWaveDurationPeriods * frequencyToPeriod(frequency);
+    const size_t kMinimumSteps = (kMinimumDuration + hop - 1) / hop;
 
-    auto end = std::end(signal);
-    auto first = end;
+    const double maxValue = *std::max_element(std::begin(probabilities),
+                                              std::end(probabilities));
 
-    for (auto it = std::begin(signal); it != end; ++it)
-    {
-        if (*it >= threshold)
-        {
-            if (first == end)
-            {
-                first = it;
-            }
-        }
-        else if (first != end)
-        {
-            result.emplace_back(first, it);
-            first = end;
-        }
-    }
-    if (first != end)
-    {
-        result.emplace_back(first, end);
-    }
+    SegmentDetectorOptions options;
+    options.upperThreshold = kProbabilityThreshold * maxValue;
+    options.lowerThreshold = options.upperThreshold;
+    options.maxGap = kMinimumSteps;
+    options.minimumLength = kMinimumSteps;
+    options.merging = GapMerging::Pairwise;
+
+    WaveDecomposition result;
+    SegmentDetector detector(options,
+                             [&](const Segment& each)
+                             {
+                                 result.emplace_back(frequency,
+                                                     (each.mean() / maxValue),
+                                                     hop * each.start,
+                                                     hop * each.length);
+                             });
+    detector.push(probabilities);
+    detector.finish();
 
     return result;
 }
 
+
 /**
- * @brief meanValue - вычисляет среднее значение последовательности, заданной парой итераторов: [first, last).
- * @param first - начало анализируемой последовательности.
- * @param last - конец анализируемой последовательности.
- * @return среднее арифметическое последовательности значений.
+ * @struct FrequencyDecomposition
+ * @brief Результаты анализа сложного сигнала для одной частоты.
  */
-template <typename Iterator>
-double meanValue(Iterator first, Iterator last)
+struct FrequencyDecomposition
 {
-    if (first == last)
-    {
-        return 0.0;
-    }
+    std::vector<double> probability; //!< Вероятность обнаружения частоты в каждом окне.
+    std::vector<double> smooth;      //!< Сглаженная вероятность обнаружения.
+    std::vector<double> detected;    //!< Признак обнаружения частоты для каждого отсчёта сигнала (вкл/выкл).
+    WaveDecomposition waves;         //!< Обнаруженные отрезки сигнала с данной частотой.
+};
 
-    return (std::accumulate(first, last, 0.0) / static_cast<double>(std::distance(first, last)));
+/**
+ * @brief windowSize - ширина окна анализа для частоты frequency: windowMultiplier периодов синусоиды (не менее одного отсчёта).
+ */
+size_t windowSize(const double frequency, const double windowMultiplier)
+{
+    return std::max<size_t>(std::lround(windowMultiplier * frequencyToPeriod(frequency)), 1);
 }
 
 /**
- * @brief meanAverageSmooth - сглаживает входной ряд значений, используя метод скользящего среднего.
- * @param sequence - входная последовательность.
- * @param windowSize - размер окна для вычисления среднего.
- * @return сглаженная последовательность.
+ * @brief expandedWindowSize - длина окна анализа шириной windowWidth после дополнения нулями
+ *        (наибольшее кратное ширины окна, не превышающее длины сигнала signalLength).
  */
-const std::vector<double> meanAverageSmooth(const std::vector<double>& sequence,
-                                            const size_t windowSize)
+size_t expandedWindowSize(const size_t windowWidth, const size_t signalLength)
 {
-    if (sequence.size() < windowSize)
-    {
-        return sequence;
-    }
-
-    std::vector<double> result(sequence);
-    auto currentOutput = std::begin(result) + windowSize / 2;
-
-    auto first = std::begin(sequence);
-    auto last = first + windowSize;
-    auto end = std::end(sequence);
-    while (last != end)
-    {
-        *(currentOutput++) = meanValue((first++), (last++));
-    }
-
-    return result;
+    const size_t expandedSize = windowWidth * (signalLength / windowWidth);
+    return std::max(expandedSize, std::min(signalLength, windowWidth));
 }
 
 /**
- * @brief joinDecomposition - объединяет последовательно расположенные окна WindowBounds набора decomposition,
- *        если промежуток между ними менее значения maxGap.
- * @param decomposition - анализируемая последовательность окон.
- * @param maxGap - максимальная длина промежутка между соседними окнами, при которой их можно объединить.
- * @param isAnyJoined - флаг результата - были ли совершены какие-либо объединения?
- * @return последовательность объединённых окон.
+ * @brief hopSize - шаг положений окна шириной windowWidth согласно параметрам options.
  */
-std::vector<WindowBounds> joinDecomposition(const std::vector<WindowBounds>& decomposition,
-                                            const size_t maxGap,
-                                            bool* isAnyJoined)
+size_t hopSize(const DecomposeOptions& options, const size_t windowWidth)
 {
-    assert(isAnyJoined != nullptr);
-    *isAnyJoined = false;
+    return (options.hop > 0 ? options.hop : std::max<size_t>(windowWidth / 4, 1));
+}
 
-    if (decomposition.size() <= 1)
+/**
+ * @brief interpolateTrack - восстанавливает значения track, усреднённые по интервалам шага hop, для каждого отсчёта [0, length)
+ *        линейной интерполяцией между серединами интервалов (за крайними серединами значения продолжаются постоянными).
+ */
+const std::vector<double> interpolateTrack(const std::vector<double>& track,
+                                           const size_t hop,
+                                           const size_t length)
+{
+    if (hop == 1 || track.empty())
     {
-        return decomposition;
+        return std::vector<double>(std::begin(track), std::begin(track) + std::min(track.size(), length));
     }
 
-    std::vector<WindowBounds> result;
-    result.reserve(decomposition.size());
-
-    auto current = std::begin(decomposition),
-         next = current + 1,
-         end = std::end(decomposition);
-
-    while (current != end && next != end)
+    const double kLastPosition = static_cast<double>(track.size() - 1);
+    std::vector<double> result(length);
+    for (size_t index = 0; index < length; ++index)
     {
-        const WindowBounds& currentWindow = *current;
-        const WindowBounds& nextWindow = *next;
-
-        if (static_cast<size_t>(std::distance(currentWindow.upper, nextWindow.lower)) <= maxGap)
-        {
-            result.emplace_back(currentWindow.lower, nextWindow.upper);
-            *isAnyJoined = true;
-        }
-        else
-        {
-            result.push_back(currentWindow);
-            result.push_back(nextWindow);
-        }
-
-        current += 2;
-        next += 2;
-    }
-
-    if (current != end)
-    {
-        result.push_back(*current);
+        // Середина интервала k приходится на отсчёт k * hop + (hop - 1) / 2.
+        const double kPosition = std::min(std::max((index + 0.5) / hop - 0.5, 0.0), kLastPosition);
+        const size_t kLower = static_cast<size_t>(kPosition);
+        const size_t kUpper = std::min(kLower + 1, track.size() - 1);
+        result[index] = track[kLower] + (track[kUpper] - track[kLower]) * (kPosition - kLower);
     }
-
     return result;
 }
 
 /**
- * @brief decomposeByProbabilites - выделяет из временного распределения вероятности обнаружения базового сигнала в сложном
- *        структуры с параметрами, характеризующими обнаруженный базовый сигнал.
- * @param probabilities - временное распределение вероятности обнаружения сигнала с частотой frequency в сложном сигнале.
+ * @brief decomposeFrequency - анализ сложного сигнала signal для одной частоты frequency
+ *        по модулям отсчёта спектра в скользящих окнах frequencyValues (см. slidingFilterBank).
+ *        Сглаживание и выделение отрезков выполняются с шагом положений окна hop,
+ *        после чего вероятности восстанавливаются для каждого положения окна с шагом в один отсчёт.
+ * @param signal - сложный сигнал.
  * @param frequency - частота базового сигнала.
- * @return набор структур Wave, характеризующих наличие базового сигнала с частотой frequency в составе сложного сигнала.
+ * @param windowWidth - ширина окна анализа.
+ * @param hop - шаг положений окна.
+ * @param frequencyValues - модули отсчёта спектра выделенной составляющей для положений окна, кратных hop.
+ * @return результаты анализа для частоты frequency.
  */
-WaveDecomposition decomposeByProbabilites(const std::vector<double>& probabilities,
-                                          const double frequency)
+FrequencyDecomposition decomposeFrequency(Span<const double> signal,
+                                          const double frequency,
+                                          const size_t windowWidth,
+                                          const size_t hop,
+                                          const std::vector<double>& frequencyValues)
 {
-    const double kThreshold = 0.45; //!< Пороговое значение вероятности, от которого считаем, что составляющая присутствует в сигнале.
-    const double maxValue = *std::max_element(std::begin(probabilities),
-                                              std::end(probabilities));
+    FrequencyDecomposition result;
 
-    std::vector<WindowBounds> windows = splitByThreshold(probabilities, (kThreshold * maxValue));
-    volatile bool isContinue = true;
-    while (isContinue)
+    const size_t coefWindowExpanding = signal.size() / windowWidth;
+
+    const SlidingWindows windows(signal, windowWidth, hop);
+    std::vector<double> probability;
+    probability.reserve(windows.size());
+    for (size_t windowIndex = 0, windowsCount = windows.size(); windowIndex < windowsCount; ++windowIndex)
     {
-        windows = joinDecomposition(windows,
-                                    (kMinimumWaveDurationPeriods * frequencyToPeriod(frequency)),
-                                    const_cast<bool*>(&isContinue));
+        // Вычисленную амплитуду сигнала для данной частоты будем считать вероятностью обнаружения данной частоты на данном отрезке сложного сигнала.
+        probability.push_back(coefWindowExpanding * frequencyValues.at(windowIndex));
     }
 
-    WaveDecomposition result;
-    for (const WindowBounds& each : windows)
+    const size_t kSmoothSteps = std::max<size_t>((windowWidth + hop / 2) / hop, 1);
+    // Последнее положение окна сглаживания не используется (последнее значение остаётся несглаженным, как и прежде).
+    std::vector<double> smooth(probability);
+    if (!smooth.empty())
     {
-        if (static_cast<size_t>(std::distance(each.lower, each.upper)) >= (kMinimumWaveDurationPeriods * frequencyToPeriod(frequency)))
-        {
-            const double windowMeanValue = meanValue(each.lower, each.upper);
-            result.emplace_back(frequency,
-                                (windowMeanValue / maxValue),
-                                std::distance(std::begin(probabilities), each.lower),
-                                std::distance(each.lower, each.upper));
-        }
+        Span<double> smoothed(smooth.data(), smooth.size() - 1);
+        smoothing::movingAverage(smoothed, kSmoothSteps, smoothed);
+    }
+    result.waves = ::decomposeByProbabilites(smooth, frequency, hop);
+    for (Wave& each : result.waves)
+    {
+        each.length = std::min<size_t>(each.length, signal.size() - each.start_idx);
+    }
+
+    const size_t kPositionsCount = SlidingWindows(signal, windowWidth).size();
+    result.probability = ::interpolateTrack(probability, hop, kPositionsCount);
+    result.smooth = ::interpolateTrack(smooth, hop, kPositionsCount);
+
+    enum
+    {
+        Off = 0,
+        On = 1
+    };
+    result.detected.assign(signal.size(), Off);
+    for (const Wave& each : result.waves)
+    {
+        std::fill(std::begin(result.detected) + each.start_idx,
+                  std::begin(result.detected) + each.start_idx + each.length,
+                  On);
     }
 
     return result;
@@ -247,83 +251,115 @@ WaveDecomposition decomposeByProbabilites(const std::vector<double>& probabiliti
 
 }
 
-WaveDecomposition decompose(const std::vector<double>& signal,
+WaveDecomposition decompose(Span<const double> signal,
                             const std::vector<double>& frequencies)
 {
+    return decompose(signal, frequencies, DecomposeOptions());
+}
+
+WaveDecomposition decompose(Span<const double> signal,
+                            const std::vector<double>& frequencies,
+                            const size_t threadsCount)
+{
+    DecomposeOptions options;
+    options.threadsCount = threadsCount;
+    return decompose(signal, frequencies, options);
+}
+
+WaveDecomposition decompose(Span<const double> signal,
+                            const std::vector<double>& frequencies,
+                            ThreadPool& pool)
+{
+    return decompose(signal, frequencies, DecomposeOptions(), pool);
+}
+
+WaveDecomposition decompose(Span<const double> signal,
+                            const std::vector<double>& frequencies,
+                            const DecomposeOptions& options)
+{
+    ThreadPool pool(options.threadsCount);
+    return decompose(signal, frequencies, options, pool);
+}
+
+WaveDecomposition decompose(Span<const double> signal,
+                            const std::vector<double>& frequencies,
+                            const DecomposeOptions& options,
+                            ThreadPool& pool)
+{
+    const size_t kFrequenciesCount = frequencies.size();
+    std::vector<FrequencyDecomposition> decompositions(kFrequenciesCount);
+
+    std::vector<size_t> windowSizes;
+    std::vector<size_t> expandedSizes;
+    std::vector<size_t> hops;
+    windowSizes.reserve(kFrequenciesCount);
+    expandedSizes.reserve(kFrequenciesCount);
+    hops.reserve(kFrequenciesCount);
+    for (const double eachFrequency : frequencies)
+    {
+        windowSizes.push_back(::windowSize(eachFrequency, options.windowMultiplier));
+        expandedSizes.push_back(::expandedWindowSize(windowSizes.back(), signal.size()));
+        hops.push_back(::hopSize(options, windowSizes.back()));
+    }
+
+    // Амплитуды всех частот во всех окнах вычисляются банком детекторов за один проход по сигналу;
+    // проход делится на фрагменты по положениям окна, которые распределяются между всеми потоками пула,
+    // так что все ядра используются даже при малом количестве частот.
+    LOG_TRACE(  "Calculate signal probabilities for " + std::to_string(kFrequenciesCount)
+              + " frequencies in " + std::to_string(pool.size()) + " threads.");
+    const std::vector<std::vector<double>> frequenciesValues = slidingFilterBank(signal,
+                                                                                 frequencies,
+                                                                                 windowSizes,
+                                                                                 expandedSizes,
+                                                                                 hops,
+                                                                                 pool);
+
+    // Дальнейший анализ частот независим: результаты записываются по индексу частоты,
+    // поэтому порядок результатов не зависит от порядка выполнения задач.
+    LOG_TRACE("Start probabilities analyzing.");
+    pool.run(kFrequenciesCount,
+             [&](const size_t i)
+             {
+                 decompositions[i] = ::decomposeFrequency(signal, frequencies[i], windowSizes[i], hops[i], frequenciesValues[i]);
+             });
+
+    // Объединение результатов в порядке исходного набора частот:
     std::vector<std::string> columnTitles;
     std::vector<std::vector<double>> columnValues;
-    columnTitles.reserve(frequencies.size() * 3);
-    columnValues.reserve(frequencies.size() * 3);
+    columnTitles.reserve(kFrequenciesCount * 3);
+    columnValues.reserve(kFrequenciesCount * 3);
     size_t length = 0;
 
-    for (size_t i = 0, size = frequencies.size(); i < size; ++i)
+    WaveDecomposition result;
+    for (size_t i = 0; i < kFrequenciesCount; ++i)
     {
-        Logger::trace("Decompose frequency " + std::to_string(i+1) + "/" + std::to_string(size) + ".");
-
-        const double& eachFrequency = frequencies.at(i);
-        const size_t kWindowSize = frequencyToPeriod(eachFrequency);
-        const size_t coefWindowExpanding = signal.size() / kWindowSize;
-        const size_t expandedSize = kWindowSize * coefWindowExpanding;
-        Logger::trace("Split to windows, window size = " + std::to_string(kWindowSize) + " discrets.");
-
-        const std::vector<WindowBounds> windowsBounds = splitToWindows(signal, kWindowSize);
-        Logger::trace("Windows count = " + std::to_string(windowsBounds.size()) + ".");
+        FrequencyDecomposition& each = decompositions[i];
+        LOG_TRACE(  "Frequency #" + std::to_string(i+1) + ": windows count = " + std::to_string(each.probability.size())
+                  + ", detected waves = " + std::to_string(each.waves.size()) + ".");
 
-        columnTitles.push_back("probability #" + std::to_string(i+1));
-        std::vector<double>& eachProbability = *(columnValues.insert(columnValues.end(), std::vector<double>()));
+        length = std::max(length, each.probability.size());
+        result.insert(std::end(result),
+                      std::begin(each.waves), std::end(each.waves));
 
-        Logger::trace("Calculate signal probabilities in windows.");
-        eachProbability.reserve(signal.size());
-        for (const auto& eachWindow : windowsBounds)
+        if (options.probabilitiesFileName.empty())
         {
-            std::vector<double> eachSignal(eachWindow.lower, eachWindow.upper);
-            if (eachSignal.size() < expandedSize)
-            {
-                eachSignal.resize(expandedSize);
-            }
-
-            std::vector<std::complex<double>> eachFilteredSpectrum;
-            filterByFrequency(eachSignal, eachFrequency, &eachFilteredSpectrum);
-            const std::complex<double> frequencyValue = eachFilteredSpectrum.at(frequencyToIndex(eachFrequency,
-                                                                                                 eachFilteredSpectrum.size()));
-            // Вычисленную амплитуду сигнала для данной частоты будем считать вероятностью обнаружения данной частоты на данном отрезке сложного сигнала.
-            eachProbability.push_back(coefWindowExpanding * modulus(frequencyValue));
+            continue;
         }
-
-        Logger::trace("Smoothing by mean average.");
+        columnTitles.push_back("probability #" + std::to_string(i+1));
+        columnValues.push_back(std::move(each.probability));
         columnTitles.push_back("smooth #" + std::to_string(i+1));
-        columnValues.push_back(::meanAverageSmooth(eachProbability, kWindowSize));
-
-        length = std::max(length, eachProbability.size());
+        columnValues.push_back(std::move(each.smooth));
     }
-
-    Logger::trace("Start probabilities analyzing.");
-    WaveDecomposition result;
-    for (size_t i = 0, size = columnValues.size(); i < size; i += 2)
+    if (!options.probabilitiesFileName.empty())
     {
-        Logger::trace("Decompose for frequency #" + std::to_string(i/2 + 1) + ".");
-        WaveDecomposition forEachFrequency = ::decomposeByProbabilites(columnValues.at(i+1),
-                                                                       frequencies.at(i/2));
-        result.insert(std::end(result),
-                      std::begin(forEachFrequency), std::end(forEachFrequency));
-
-        columnTitles.push_back("detected on/off #" + std::to_string(i/2 + 1));
-        enum
+        for (size_t i = 0; i < kFrequenciesCount; ++i)
         {
-            Off = 0,
-            On = 1
-        };
-        auto inserted = columnValues.insert(columnValues.end(),
-                                            std::vector<double>(signal.size(), Off));
-        for (const Wave& each : forEachFrequency)
-        {
-            std::fill(std::begin(*inserted) + each.start_idx,
-                      std::begin(*inserted) + each.start_idx + each.length,
-                      On);
+            columnTitles.push_back("detected on/off #" + std::to_string(i+1));
+            columnValues.push_back(std::move(decompositions[i].detected));
         }
-    }
 
-    writeValuesToCsv("base_probabilities.csv", columnTitles, length, columnValues);
+        writeValues(options.probabilitiesFileName, columnTitles, length, columnValues);
+    }
 
     return result;
 }
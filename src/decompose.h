@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include "span.h"
+#include "threadpool.h"
 #include "wave.h"
 
 /**
@@ -12,13 +14,84 @@
  */
 const size_t kMinimumWaveDurationPeriods = 5;
 
+/**
+ * @brief kProbabilityThreshold - пороговое значение вероятности (относительно наибольшей),
+ *        от которого считаем, что составляющая присутствует в сигнале.
+ */
+const double kProbabilityThreshold = 0.45;
+
+/**
+ * @struct DecomposeOptions
+ * @brief Параметры анализа сигнала в скользящих окнах.
+ */
+struct DecomposeOptions
+{
+    size_t hop = 1;                //!< Шаг положений окна анализа (в отсчётах); 0 - четверть ширины окна каждой частоты.
+    double windowMultiplier = 1.0; //!< Ширина окна анализа (в периодах частоты).
+    size_t threadsCount = 1;       //!< Количество потоков (0 - по количеству ядер процессора).
+
+    /// Файл, в который записываются вероятности, сглаженные вероятности и признаки обнаружения по окнам
+    /// (пустое имя - не записывать).
+    std::string probabilitiesFileName = "base_probabilities.csv";
+};
+
 /**
  * @brief decompose - реализация алгоритма декомпозиции сигнала signal на составляющие базовые сигналы с частотами frequencies.
  * @param signal - сложный сигнал, систавленный из суммы простых сигналов с частотами frequencies.
  * @param frequencies - набор частот, составляющих сложный сигнал.
  * @return набор характеристик базовых сигналов, выделенных из состава сложного.
  */
-WaveDecomposition decompose(const std::vector<double>& signal,
+WaveDecomposition decompose(Span<const double> signal,
                             const std::vector<double>& frequencies);
 
+/**
+ * @brief decompose - параллельная декомпозиция сигнала signal на составляющие базовые сигналы с частотами frequencies.
+ *        Частоты обрабатываются независимо в threadsCount потоках, результаты объединяются в порядке frequencies.
+ * @param signal - сложный сигнал, систавленный из суммы простых сигналов с частотами frequencies.
+ * @param frequencies - набор частот, составляющих сложный сигнал.
+ * @param threadsCount - количество потоков (0 - по количеству ядер процессора).
+ * @return набор характеристик базовых сигналов, выделенных из состава сложного.
+ */
+WaveDecomposition decompose(Span<const double> signal,
+                            const std::vector<double>& frequencies,
+                            const size_t threadsCount);
+
+/**
+ * @brief decompose - параллельная декомпозиция сигнала signal с использованием пула потоков pool.
+ * @param signal - сложный сигнал, систавленный из суммы простых сигналов с частотами frequencies.
+ * @param frequencies - набор частот, составляющих сложный сигнал.
+ * @param pool - пул потоков, в котором обрабатываются частоты.
+ * @return набор характеристик базовых сигналов, выделенных из состава сложного.
+ */
+WaveDecomposition decompose(Span<const double> signal,
+                            const std::vector<double>& frequencies,
+                            ThreadPool& pool);
+
+/**
+ * @brief decompose - декомпозиция сигнала signal с параметрами анализа options.
+ *        Значения вероятности вычисляются с шагом options.hop и восстанавливаются для каждого отсчёта
+ *        линейной интерполяцией; индексы и длительности обнаруженных отрезков кратны шагу.
+ * @param signal - сложный сигнал, систавленный из суммы простых сигналов с частотами frequencies.
+ * @param frequencies - набор частот, составляющих сложный сигнал.
+ * @param options - параметры анализа.
+ * @return набор характеристик базовых сигналов, выделенных из состава сложного.
+ */
+WaveDecomposition decompose(Span<const double> signal,
+                            const std::vector<double>& frequencies,
+                            const DecomposeOptions& options);
+
+/**
+ * @brief decompose - декомпозиция сигнала signal с параметрами анализа options в пуле потоков pool
+ *        (options.threadsCount не используется).
+ * @param signal - сложный сигнал, систавленный из суммы простых сигналов с частотами frequencies.
+ * @param frequencies - набор частот, составляющих сложный сигнал.
+ * @param options - параметры анализа.
+ * @param pool - пул потоков, в котором обрабатываются частоты.
+ * @return набор характеристик базовых сигналов, выделенных из состава сложного.
+ */
+WaveDecomposition decompose(Span<const double> signal,
+                            const std::vector<double>& frequencies,
+                            const DecomposeOptions& options,
+                            ThreadPool& pool);
+
 #endif // DECOMPOSE_H
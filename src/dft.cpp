@@ -7,40 +7,97 @@
 namespace fourier
 {
 
-const std::vector<std::complex<double>> dft(const std::vector<double>& signal)
+const std::vector<std::complex<double>> dft(Span<const double> signal)
 {
     const size_t kLength = signal.size();
-    std::vector<std::complex<double>> spectrum(kLength, { 0.0, 0.0 });
 
-    for (size_t spectrumIndex = 0; spectrumIndex < kLength; ++spectrumIndex)
+    // Спектр действительного сигнала вычисляется по половине и достраивается по эрмитовой симметрии.
+    RealFftPlan plan(kLength);
+    std::vector<std::complex<double>> spectrum = realDft(signal, plan);
+    spectrum.resize(kLength);
+    for (size_t k = plan.spectrumSize(); k < kLength; ++k)
     {
-        std::complex<double> sum(0.0, 0.0);
-        for (size_t signalIndex = 0; signalIndex < kLength; ++signalIndex)
-        {
-            sum += signal[signalIndex] * std::exp(kImaginaryUnit * -2.0 * M_PI * static_cast<double>(spectrumIndex) * static_cast<double>(signalIndex) / static_cast<double>(kLength));
-        }
-        spectrum[spectrumIndex] = sum / static_cast<double>(kLength);
+        spectrum[k] = std::conj(spectrum[kLength - k]);
     }
     return spectrum;
 }
 
-const std::vector<double> inverseDft(const std::vector<std::complex<double>>& spectrum)
+const std::vector<std::complex<double>> dft(Span<const double> signal, FftPlan& plan)
 {
-    const size_t kLength = spectrum.size();
-    std::vector<double> signal(kLength, 0.0);
+    const size_t kLength = signal.size();
+    std::vector<std::complex<double>> spectrum(std::begin(signal), std::end(signal));
+
+    plan.forward(spectrum);
+
+    const double kScale = 1.0 / static_cast<double>(kLength);
+    for (std::complex<double>& each : spectrum)
+    {
+        each *= kScale;
+    }
+    return spectrum;
+}
+
+const std::vector<std::complex<double>> realDft(Span<const double> signal)
+{
+    RealFftPlan plan(signal.size());
+    return realDft(signal, plan);
+}
 
-    for (size_t spectrumIndex = 0; spectrumIndex < kLength; ++spectrumIndex)
+const std::vector<std::complex<double>> realDft(Span<const double> signal, RealFftPlan& plan)
+{
+    std::vector<std::complex<double>> spectrum;
+    realDft(signal, plan, spectrum);
+    return spectrum;
+}
+
+void realDft(Span<const double> signal, RealFftPlan& plan, std::vector<std::complex<double>>& spectrum)
+{
+    plan.forward(signal, spectrum);
+
+    const double kScale = 1.0 / static_cast<double>(signal.size());
+    for (std::complex<double>& each : spectrum)
     {
-        const std::vector<double> harmonic = inverseDft(spectrum, spectrumIndex);
-        for (size_t signalIndex = 0; signalIndex < kLength; ++signalIndex)
-        {
-            signal[signalIndex] += harmonic[signalIndex];
-        }
+        each *= kScale;
     }
+}
+
+const std::vector<double> inverseDft(Span<const std::complex<double>> spectrum)
+{
+    FftPlan plan(spectrum.size());
+    return inverseDft(spectrum, plan);
+}
+
+const std::vector<double> inverseDft(Span<const std::complex<double>> spectrum, FftPlan& plan)
+{
+    std::vector<double> signal;
+    inverseDft(spectrum, plan, signal);
+    return signal;
+}
+
+void inverseDft(Span<const std::complex<double>> spectrum, FftPlan& plan, std::vector<double>& signal)
+{
+    plan.inverse(spectrum, signal);
+}
+
+const std::vector<double> inverseRealDft(Span<const std::complex<double>> spectrum, const size_t length)
+{
+    RealFftPlan plan(length);
+    return inverseRealDft(spectrum, plan);
+}
+
+const std::vector<double> inverseRealDft(Span<const std::complex<double>> spectrum, RealFftPlan& plan)
+{
+    std::vector<double> signal;
+    inverseRealDft(spectrum, plan, signal);
     return signal;
 }
 
-const std::vector<double> inverseDft(const std::vector<std::complex<double>>& spectrum, const size_t spectrumIndex)
+void inverseRealDft(Span<const std::complex<double>> spectrum, RealFftPlan& plan, std::vector<double>& signal)
+{
+    plan.inverse(spectrum, signal);
+}
+
+const std::vector<double> inverseDft(Span<const std::complex<double>> spectrum, const size_t spectrumIndex)
 {
     const size_t kLength = spectrum.size();
     std::vector<double> sineSignal(kLength, 0.0);
@@ -4,6 +4,9 @@
 #include <complex>
 #include <vector>
 
+#include "fft.h"
+#include "span.h"
+
 namespace fourier
 {
 /**
@@ -12,7 +15,43 @@ namespace fourier
  * @param signal - преобразуемый сигнал.
  * @return спектр сигнала.
  */
-const std::vector<std::complex<double>> dft(const std::vector<double>& signal);
+const std::vector<std::complex<double>> dft(Span<const double> signal);
+
+/**
+ * @brief dft - вычисление дискретного преобразования Фурье сигнала signal
+ *        с использованием заранее построенного плана преобразования plan.
+ * @param signal - преобразуемый сигнал.
+ * @param plan - план преобразования длины signal.size().
+ * @return спектр сигнала.
+ */
+const std::vector<std::complex<double>> dft(Span<const double> signal, FftPlan& plan);
+
+/**
+ * @brief realDft - вычисление дискретного преобразования Фурье действительного сигнала signal.
+ *        Спектр действительного сигнала эрмитово-симметричен, поэтому возвращается только его
+ *        неотрицательная половина: отсчёты с индексами [0, N/2], где N = signal.size().
+ * @param signal - преобразуемый сигнал.
+ * @return половина спектра сигнала (N/2+1 отсчётов).
+ */
+const std::vector<std::complex<double>> realDft(Span<const double> signal);
+
+/**
+ * @brief realDft - вычисление половины спектра действительного сигнала signal
+ *        с использованием заранее построенного плана преобразования plan.
+ * @param signal - преобразуемый сигнал.
+ * @param plan - план преобразования длины signal.size().
+ * @return половина спектра сигнала (N/2+1 отсчётов).
+ */
+const std::vector<std::complex<double>> realDft(Span<const double> signal, RealFftPlan& plan);
+
+/**
+ * @brief realDft - вычисление половины спектра действительного сигнала signal с записью результата в буфер spectrum,
+ *        предоставленный вызывающей стороной (память выделяется лишь при нехватке ёмкости).
+ * @param signal - преобразуемый сигнал.
+ * @param plan - план преобразования длины signal.size().
+ * @param spectrum - половина спектра сигнала (N/2+1 отсчётов).
+ */
+void realDft(Span<const double> signal, RealFftPlan& plan, std::vector<std::complex<double>>& spectrum);
 
 /**
  * @brief inverse_dft - вычисление обратного дискретного преобразования Фурье
@@ -20,7 +59,52 @@ const std::vector<std::complex<double>> dft(const std::vector<double>& signal);
  * @param spectrum - спектр сигнала.
  * @return последовательность отсчётов восстановленного сигнала (только его действительная часть).
  */
-const std::vector<double> inverseDft(const std::vector<std::complex<double>>& spectrum);
+const std::vector<double> inverseDft(Span<const std::complex<double>> spectrum);
+
+/**
+ * @brief inverse_dft - вычисление обратного дискретного преобразования Фурье для сигнала, представленного спектром spectrum,
+ *        с использованием заранее построенного плана преобразования plan.
+ * @param spectrum - спектр сигнала.
+ * @param plan - план преобразования длины spectrum.size().
+ * @return последовательность отсчётов восстановленного сигнала (только его действительная часть).
+ */
+const std::vector<double> inverseDft(Span<const std::complex<double>> spectrum, FftPlan& plan);
+
+/**
+ * @brief inverse_dft - вычисление обратного дискретного преобразования Фурье для сигнала, представленного спектром spectrum,
+ *        с записью результата в буфер signal, предоставленный вызывающей стороной (память выделяется лишь при нехватке ёмкости).
+ * @param spectrum - спектр сигнала.
+ * @param plan - план преобразования длины spectrum.size().
+ * @param signal - последовательность отсчётов восстановленного сигнала (только его действительная часть).
+ */
+void inverseDft(Span<const std::complex<double>> spectrum, FftPlan& plan, std::vector<double>& signal);
+
+/**
+ * @brief inverseRealDft - вычисление обратного дискретного преобразования Фурье
+ *        для действительного сигнала длины length, представленного половиной спектра spectrum (см. realDft).
+ * @param spectrum - половина спектра сигнала (length/2+1 отсчётов).
+ * @param length - длина восстанавливаемого сигнала.
+ * @return последовательность отсчётов восстановленного сигнала.
+ */
+const std::vector<double> inverseRealDft(Span<const std::complex<double>> spectrum, const size_t length);
+
+/**
+ * @brief inverseRealDft - вычисление обратного дискретного преобразования Фурье для действительного сигнала,
+ *        представленного половиной спектра spectrum, с использованием заранее построенного плана преобразования plan.
+ * @param spectrum - половина спектра сигнала (plan.spectrumSize() отсчётов).
+ * @param plan - план преобразования длины восстанавливаемого сигнала.
+ * @return последовательность отсчётов восстановленного сигнала.
+ */
+const std::vector<double> inverseRealDft(Span<const std::complex<double>> spectrum, RealFftPlan& plan);
+
+/**
+ * @brief inverseRealDft - вычисление обратного дискретного преобразования Фурье для действительного сигнала,
+ *        представленного половиной спектра spectrum, с записью результата в буфер signal, предоставленный вызывающей стороной.
+ * @param spectrum - половина спектра сигнала (plan.spectrumSize() отсчётов).
+ * @param plan - план преобразования длины восстанавливаемого сигнала.
+ * @param signal - последовательность отсчётов восстановленного сигнала.
+ */
+void inverseRealDft(Span<const std::complex<double>> spectrum, RealFftPlan& plan, std::vector<double>& signal);
 
 /**
  * @brief inverse_dft - вычисление обратного дискретного преобразования Фурье
@@ -29,7 +113,7 @@ const std::vector<double> inverseDft(const std::vector<std::complex<double>>& sp
  * @param spectrumIndex - индекс в последовательность спктра, соответствующий частоте восстанавливаемой гармоники.
  * @return последовательность отсчётов восстановленной гармоники сигнала (только действительная часть).
  */
-const std::vector<double> inverseDft(const std::vector<std::complex<double>>& spectrum, const size_t spectrumIndex);
+const std::vector<double> inverseDft(Span<const std::complex<double>> spectrum, const size_t spectrumIndex);
 
 } // fourier
 
@@ -0,0 +1,455 @@
+#include "fft.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace
+{
+
+/**
+ * @brief factorize - раскладывает длину преобразования length на основания 4, 2, 3 и 5.
+ * @param length - длина преобразования.
+ * @param factors - набор оснований, произведение которых равно length.
+ * @return true, если length полностью раскладывается на указанные основания.
+ */
+bool factorize(size_t length, std::vector<size_t>& factors)
+{
+    factors.clear();
+    for (const size_t radix : { 4, 2, 3, 5 })
+    {
+        while (length % radix == 0 && length > 1)
+        {
+            factors.push_back(radix);
+            length /= radix;
+        }
+    }
+    return (length == 1);
+}
+
+/**
+ * @brief digitReversal - вычисляет перестановку входной последовательности для алгоритма прореживания по времени
+ *        со смешанными основаниями factors (обобщение бит-реверсной перестановки).
+ * @param length - длина преобразования.
+ * @param factors - основания этапов преобразования.
+ * @return набор индексов: i-й элемент переставленной последовательности берётся из позиции result[i].
+ */
+const std::vector<size_t> digitReversal(const size_t length, const std::vector<size_t>& factors)
+{
+    std::vector<size_t> result(length, 0);
+    for (size_t index = 0; index < length; ++index)
+    {
+        size_t position = 0;
+        size_t rest = index;
+        size_t width = length;
+        for (auto it = factors.crbegin(), end = factors.crend(); it != end; ++it)
+        {
+            width /= *it;
+            position += (rest % *it) * width;
+            rest /= *it;
+        }
+        result[position] = index;
+    }
+    return result;
+}
+
+/**
+ * @brief makeTwiddles - вычисляет поворачивающие множители exp(-2*pi*i*k/length) для k = [0, length).
+ */
+const std::vector<std::complex<double>> makeTwiddles(const size_t length)
+{
+    std::vector<std::complex<double>> result(length);
+    for (size_t k = 0; k < length; ++k)
+    {
+        const double angle = 2.0 * M_PI * static_cast<double>(k) / static_cast<double>(length);
+        result[k] = { std::cos(angle), -std::sin(angle) };
+    }
+    return result;
+}
+
+/**
+ * @brief mulMinusI - возвращает произведение value * (-i).
+ */
+inline std::complex<double> mulMinusI(const std::complex<double>& value)
+{
+    return { value.imag(), -value.real() };
+}
+
+/**
+ * @brief butterflies - этапы прямого преобразования Фурье со смешанными основаниями (прореживание по времени)
+ *        над уже переставленной (см. digitReversal) последовательностью data.
+ * @param data - преобразуемая последовательность (результат записывается на её место).
+ * @param factors - основания этапов преобразования.
+ * @param twiddles - поворачивающие множители (см. makeTwiddles).
+ */
+void butterflies(std::vector<std::complex<double>>& data,
+                 const std::vector<size_t>& factors,
+                 const std::vector<std::complex<double>>& twiddles)
+{
+    const size_t kLength = data.size();
+
+    const double kSin60 = std::sqrt(3.0) / 2.0;
+    const double kCos72 = std::cos(2.0 * M_PI / 5.0);
+    const double kCos144 = std::cos(4.0 * M_PI / 5.0);
+    const double kSin72 = std::sin(2.0 * M_PI / 5.0);
+    const double kSin144 = std::sin(4.0 * M_PI / 5.0);
+
+    size_t m = 1;
+    for (const size_t radix : factors)
+    {
+        const size_t span = m * radix;
+        const size_t stride = kLength / span;
+
+        for (size_t k = 0; k < m; ++k)
+        {
+            const std::complex<double> w1 = twiddles[k * stride];
+            const std::complex<double> w2 = twiddles[2 * k * stride];
+            const std::complex<double> w3 = (radix > 3 ? twiddles[3 * k * stride] : w1);
+            const std::complex<double> w4 = (radix > 4 ? twiddles[4 * k * stride] : w1);
+
+            for (size_t block = 0; block < kLength; block += span)
+            {
+                std::complex<double>* const x = data.data() + block + k;
+                switch (radix)
+                {
+                case 2:
+                {
+                    const std::complex<double> t0 = x[0];
+                    const std::complex<double> t1 = x[m] * w1;
+                    x[0] = t0 + t1;
+                    x[m] = t0 - t1;
+                    break;
+                }
+                case 3:
+                {
+                    const std::complex<double> t0 = x[0];
+                    const std::complex<double> t1 = x[m] * w1;
+                    const std::complex<double> t2 = x[2 * m] * w2;
+                    const std::complex<double> sum = t1 + t2;
+                    const std::complex<double> base = t0 - 0.5 * sum;
+                    const std::complex<double> rotated = mulMinusI(kSin60 * (t1 - t2));
+                    x[0] = t0 + sum;
+                    x[m] = base + rotated;
+                    x[2 * m] = base - rotated;
+                    break;
+                }
+                case 4:
+                {
+                    const std::complex<double> t0 = x[0];
+                    const std::complex<double> t1 = x[m] * w1;
+                    const std::complex<double> t2 = x[2 * m] * w2;
+                    const std::complex<double> t3 = x[3 * m] * w3;
+                    const std::complex<double> a0 = t0 + t2;
+                    const std::complex<double> a1 = t0 - t2;
+                    const std::complex<double> b0 = t1 + t3;
+                    const std::complex<double> b1 = mulMinusI(t1 - t3);
+                    x[0] = a0 + b0;
+                    x[m] = a1 + b1;
+                    x[2 * m] = a0 - b0;
+                    x[3 * m] = a1 - b1;
+                    break;
+                }
+                case 5:
+                {
+                    const std::complex<double> t0 = x[0];
+                    const std::complex<double> t1 = x[m] * w1;
+                    const std::complex<double> t2 = x[2 * m] * w2;
+                    const std::complex<double> t3 = x[3 * m] * w3;
+                    const std::complex<double> t4 = x[4 * m] * w4;
+                    const std::complex<double> a1 = t1 + t4;
+                    const std::complex<double> b1 = t1 - t4;
+                    const std::complex<double> a2 = t2 + t3;
+                    const std::complex<double> b2 = t2 - t3;
+                    const std::complex<double> base1 = t0 + kCos72 * a1 + kCos144 * a2;
+                    const std::complex<double> base2 = t0 + kCos144 * a1 + kCos72 * a2;
+                    const std::complex<double> rotated1 = mulMinusI(kSin72 * b1 + kSin144 * b2);
+                    const std::complex<double> rotated2 = mulMinusI(kSin144 * b1 - kSin72 * b2);
+                    x[0] = t0 + a1 + a2;
+                    x[m] = base1 + rotated1;
+                    x[2 * m] = base2 + rotated2;
+                    x[3 * m] = base2 - rotated2;
+                    x[4 * m] = base1 - rotated1;
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+        }
+        m = span;
+    }
+}
+
+}
+
+namespace fourier
+{
+
+FftPlan::FftPlan(const size_t length) :
+    m_length(length)
+{
+    if (m_length <= 1)
+    {
+        return;
+    }
+
+    if (::factorize(m_length, m_factors))
+    {
+        m_permutation = ::digitReversal(m_length, m_factors);
+        m_twiddles = ::makeTwiddles(m_length);
+        m_buffer.resize(m_length);
+        return;
+    }
+
+    m_factors.clear();
+
+    size_t convolutionLength = 1;
+    while (convolutionLength < 2 * m_length - 1)
+    {
+        convolutionLength *= 2;
+    }
+    m_convolutionPlan.reset(new FftPlan(convolutionLength));
+    m_buffer.resize(convolutionLength);
+
+    // chirp[k] = exp(-i*pi*k^2/N), k^2 берётся по модулю 2N для сохранения точности на больших длинах.
+    m_chirp.resize(m_length);
+    size_t squareModulo = 0;
+    for (size_t k = 0; k < m_length; ++k)
+    {
+        const double angle = M_PI * static_cast<double>(squareModulo) / static_cast<double>(m_length);
+        m_chirp[k] = { std::cos(angle), -std::sin(angle) };
+        squareModulo = (squareModulo + 2 * k + 1) % (2 * m_length);
+    }
+
+    m_chirpSpectrum.assign(convolutionLength, { 0.0, 0.0 });
+    for (size_t k = 0; k < m_length; ++k)
+    {
+        m_chirpSpectrum[k] = std::conj(m_chirp[k]);
+        if (k != 0)
+        {
+            m_chirpSpectrum[convolutionLength - k] = m_chirpSpectrum[k];
+        }
+    }
+    m_convolutionPlan->forward(m_chirpSpectrum);
+
+    // Нормировка обратного преобразования свёртки учитывается заранее.
+    const double kScale = 1.0 / static_cast<double>(convolutionLength);
+    for (std::complex<double>& each : m_chirpSpectrum)
+    {
+        each *= kScale;
+    }
+}
+
+FftPlan::~FftPlan() = default;
+
+size_t FftPlan::size() const
+{
+    return m_length;
+}
+
+void FftPlan::forward(std::vector<std::complex<double>>& values)
+{
+    assert(values.size() == m_length);
+
+    if (m_length <= 1)
+    {
+        return;
+    }
+
+    if (m_convolutionPlan == nullptr)
+    {
+        mixedRadix(values);
+    }
+    else
+    {
+        bluestein(values);
+    }
+}
+
+void FftPlan::inverse(std::vector<std::complex<double>>& values)
+{
+    // Обратное преобразование: IFFT(x) = conj(FFT(conj(x))).
+    std::transform(std::begin(values), std::end(values), std::begin(values),
+                   [](const std::complex<double>& each) { return std::conj(each); });
+    forward(values);
+    std::transform(std::begin(values), std::end(values), std::begin(values),
+                   [](const std::complex<double>& each) { return std::conj(each); });
+}
+
+void FftPlan::inverse(Span<const std::complex<double>> spectrum, std::vector<double>& signal)
+{
+    assert(spectrum.size() == m_length);
+
+    m_workspace.assign(std::begin(spectrum), std::end(spectrum));
+    inverse(m_workspace);
+
+    signal.resize(m_length);
+    std::transform(std::begin(m_workspace), std::end(m_workspace), std::begin(signal),
+                   [](const std::complex<double>& each) { return each.real(); });
+}
+
+void FftPlan::mixedRadix(std::vector<std::complex<double>>& values)
+{
+    for (size_t i = 0; i < m_length; ++i)
+    {
+        m_buffer[i] = values[m_permutation[i]];
+    }
+
+    ::butterflies(m_buffer, m_factors, m_twiddles);
+
+    values.swap(m_buffer);
+}
+
+void FftPlan::bluestein(std::vector<std::complex<double>>& values)
+{
+    std::fill(std::begin(m_buffer) + m_length, std::end(m_buffer), std::complex<double>(0.0, 0.0));
+    for (size_t k = 0; k < m_length; ++k)
+    {
+        m_buffer[k] = values[k] * m_chirp[k];
+    }
+
+    m_convolutionPlan->forward(m_buffer);
+    std::transform(std::begin(m_buffer), std::end(m_buffer),
+                   std::begin(m_chirpSpectrum),
+                   std::begin(m_buffer),
+                   [](const std::complex<double>& eachSignal,
+                      const std::complex<double>& eachKernel)
+                   { return std::conj(eachSignal * eachKernel); });
+    m_convolutionPlan->forward(m_buffer);
+
+    for (size_t k = 0; k < m_length; ++k)
+    {
+        values[k] = m_chirp[k] * std::conj(m_buffer[k]);
+    }
+}
+
+RealFftPlan::RealFftPlan(const size_t length) :
+    m_length(length),
+    m_plan(length % 2 == 0 ? length / 2 : length)
+{
+    m_buffer.resize(m_plan.size());
+
+    if (m_length % 2 == 0)
+    {
+        const size_t kHalf = m_length / 2;
+        m_twiddles.resize(kHalf + 1);
+        for (size_t k = 0; k <= kHalf; ++k)
+        {
+            const double angle = 2.0 * M_PI * static_cast<double>(k) / static_cast<double>(m_length);
+            m_twiddles[k] = { std::cos(angle), -std::sin(angle) };
+        }
+    }
+}
+
+size_t RealFftPlan::size() const
+{
+    return m_length;
+}
+
+size_t RealFftPlan::spectrumSize() const
+{
+    return (m_length == 0 ? 0 : m_length / 2 + 1);
+}
+
+void RealFftPlan::forward(Span<const double> signal, std::vector<std::complex<double>>& spectrum)
+{
+    assert(signal.size() == m_length);
+
+    spectrum.resize(spectrumSize());
+    if (m_length == 0)
+    {
+        return;
+    }
+
+    if (m_length % 2 != 0)
+    {
+        std::copy(std::begin(signal), std::end(signal), std::begin(m_buffer));
+        m_plan.forward(m_buffer);
+        std::copy(std::begin(m_buffer), std::begin(m_buffer) + spectrum.size(), std::begin(spectrum));
+        return;
+    }
+
+    // Чётные и нечётные отсчёты упаковываются в действительную и мнимую части: z[n] = x[2n] + i*x[2n+1].
+    const size_t kHalf = m_length / 2;
+    for (size_t n = 0; n < kHalf; ++n)
+    {
+        m_buffer[n] = { signal[2 * n], signal[2 * n + 1] };
+    }
+    m_plan.forward(m_buffer);
+
+    // X[k] = E[k] + W^k * O[k], где E = (Z[k] + conj(Z[N/2-k])) / 2, O = (Z[k] - conj(Z[N/2-k])) / 2i.
+    for (size_t k = 0; k <= kHalf; ++k)
+    {
+        const std::complex<double> direct = m_buffer[k % kHalf];
+        const std::complex<double> mirrored = std::conj(m_buffer[(kHalf - k) % kHalf]);
+        const std::complex<double> even = 0.5 * (direct + mirrored);
+        const std::complex<double> odd = 0.5 * ::mulMinusI(direct - mirrored);
+        spectrum[k] = even + m_twiddles[k] * odd;
+    }
+}
+
+void RealFftPlan::inverse(Span<const std::complex<double>> spectrum, std::vector<double>& signal)
+{
+    assert(spectrum.size() == spectrumSize());
+
+    signal.resize(m_length);
+    if (m_length == 0)
+    {
+        return;
+    }
+
+    const size_t kLast = spectrum.size() - 1;
+    auto binValue = [&spectrum, kLast](const size_t k) -> std::complex<double>
+    {
+        return ((k == 0 || k == kLast) ? std::complex<double>(spectrum[k].real(), 0.0)
+                                       : spectrum[k]);
+    };
+
+    if (m_length % 2 != 0)
+    {
+        m_buffer[0] = binValue(0);
+        for (size_t k = 1; k <= kLast; ++k)
+        {
+            m_buffer[k] = spectrum[k];
+            m_buffer[m_length - k] = std::conj(spectrum[k]);
+        }
+        m_plan.inverse(m_buffer);
+        std::transform(std::begin(m_buffer), std::end(m_buffer), std::begin(signal),
+                       [](const std::complex<double>& each) { return each.real(); });
+        return;
+    }
+
+    // Обратная операция к упаковке: Z[k] = E[k] + i*O[k], E = (X[k] + X[k+N/2]) / 2, O = (X[k] - X[k+N/2]) * W^-k / 2.
+    const size_t kHalf = m_length / 2;
+    for (size_t k = 0; k < kHalf; ++k)
+    {
+        const std::complex<double> direct = binValue(k);
+        const std::complex<double> shifted = std::conj(binValue(kHalf - k));
+        const std::complex<double> even = 0.5 * (direct + shifted);
+        const std::complex<double> odd = 0.5 * (direct - shifted) * std::conj(m_twiddles[k]);
+        m_buffer[k] = { even.real() - odd.imag(), even.imag() + odd.real() };
+    }
+    m_plan.inverse(m_buffer);
+
+    // Обратное преобразование длины N/2 даёт (N/2)*x, поэтому для согласования с преобразованием длины N результат удваивается.
+    for (size_t n = 0; n < kHalf; ++n)
+    {
+        signal[2 * n] = 2.0 * m_buffer[n].real();
+        signal[2 * n + 1] = 2.0 * m_buffer[n].imag();
+    }
+}
+
+void fft(std::vector<std::complex<double>>& values, const bool isInverse)
+{
+    FftPlan plan(values.size());
+    if (isInverse)
+    {
+        plan.inverse(values);
+    }
+    else
+    {
+        plan.forward(values);
+    }
+}
+
+} // fourier
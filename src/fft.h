@@ -0,0 +1,136 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex>
+#include <memory>
+#include <vector>
+
+#include "span.h"
+
+namespace fourier
+{
+/**
+ * @class FftPlan
+ * @brief План быстрого преобразования Фурье фиксированной длины.
+ *        Хранит разложение длины на основания, перестановку входной последовательности,
+ *        поворачивающие множители и рабочие буферы, поэтому многократные преобразования
+ *        одной длины не требуют их повторного вычисления.
+ *        Длины, раскладываемые на множители 2, 3, 4 и 5, вычисляются смешанным по основанию алгоритмом,
+ *        прочие длины (содержащие простые множители больше 5) - алгоритмом Блюстейна (chirp-z).
+ *
+ * @note Рабочие буферы плана изменяются при каждом преобразовании, поэтому один план
+ *       нельзя одновременно использовать из нескольких потоков.
+ */
+class FftPlan
+{
+public:
+    explicit FftPlan(const size_t length);
+    ~FftPlan();
+
+    FftPlan(const FftPlan&) = delete;
+    FftPlan& operator=(const FftPlan&) = delete;
+
+    /**
+     * @brief size - длина преобразования, для которой построен план.
+     */
+    size_t size() const;
+
+    /**
+     * @brief forward - прямое преобразование последовательности values "на месте" (без нормировки).
+     * @param values - преобразуемая последовательность длины size().
+     */
+    void forward(std::vector<std::complex<double>>& values);
+
+    /**
+     * @brief inverse - обратное преобразование последовательности values "на месте" (без нормировки).
+     * @param values - преобразуемая последовательность длины size().
+     */
+    void inverse(std::vector<std::complex<double>>& values);
+
+    /**
+     * @brief inverse - обратное преобразование спектра spectrum (без нормировки) с сохранением только действительной части результата.
+     *        Промежуточные значения хранятся в рабочем буфере плана, поэтому при повторных вызовах память не выделяется.
+     * @param spectrum - преобразуемый спектр длины size().
+     * @param signal - действительная часть результата (размер приводится к size()).
+     */
+    void inverse(Span<const std::complex<double>> spectrum, std::vector<double>& signal);
+
+private:
+    void mixedRadix(std::vector<std::complex<double>>& values);
+    void bluestein(std::vector<std::complex<double>>& values);
+
+private:
+    size_t m_length = 0;
+
+    std::vector<size_t> m_factors;                    //!< Основания этапов преобразования (пусто, если используется алгоритм Блюстейна).
+    std::vector<size_t> m_permutation;                //!< Перестановка входной последовательности.
+    std::vector<std::complex<double>> m_twiddles;     //!< Поворачивающие множители exp(-2*pi*i*k/N).
+    std::vector<std::complex<double>> m_buffer;       //!< Рабочий буфер.
+    std::vector<std::complex<double>> m_workspace;    //!< Буфер для преобразований с отдельным выходом.
+
+    std::vector<std::complex<double>> m_chirp;        //!< chirp-последовательность exp(-i*pi*k^2/N) алгоритма Блюстейна.
+    std::vector<std::complex<double>> m_chirpSpectrum; //!< Нормированный спектр ядра свёртки алгоритма Блюстейна.
+    std::unique_ptr<FftPlan> m_convolutionPlan;       //!< План преобразований длины свёртки (степень двойки).
+};
+
+/**
+ * @class RealFftPlan
+ * @brief План быстрого преобразования Фурье действительной последовательности фиксированной длины N.
+ *        Спектр действительного сигнала эрмитово-симметричен (X[N-k] = conj(X[k])), поэтому хранится
+ *        только его неотрицательная половина - N/2+1 отсчётов. Для чётных N преобразование сводится
+ *        к комплексному преобразованию длины N/2 (вдвое меньше вычислений и памяти),
+ *        для нечётных - выполняется комплексное преобразование длины N.
+ *
+ * @note Как и FftPlan, один план нельзя одновременно использовать из нескольких потоков.
+ */
+class RealFftPlan
+{
+public:
+    explicit RealFftPlan(const size_t length);
+
+    RealFftPlan(const RealFftPlan&) = delete;
+    RealFftPlan& operator=(const RealFftPlan&) = delete;
+
+    /**
+     * @brief size - длина действительной последовательности, для которой построен план.
+     */
+    size_t size() const;
+
+    /**
+     * @brief spectrumSize - количество хранимых отсчётов спектра (N/2+1).
+     */
+    size_t spectrumSize() const;
+
+    /**
+     * @brief forward - прямое преобразование действительной последовательности signal (без нормировки).
+     * @param signal - преобразуемая последовательность длины size().
+     * @param spectrum - неотрицательная половина спектра (spectrumSize() отсчётов).
+     */
+    void forward(Span<const double> signal, std::vector<std::complex<double>>& spectrum);
+
+    /**
+     * @brief inverse - обратное преобразование эрмитова спектра, заданного неотрицательной половиной spectrum (без нормировки).
+     *        Мнимые части нулевого отсчёта и (для чётных N) отсчёта частоты Найквиста игнорируются.
+     * @param spectrum - неотрицательная половина спектра (spectrumSize() отсчётов).
+     * @param signal - восстановленная действительная последовательность длины size().
+     */
+    void inverse(Span<const std::complex<double>> spectrum, std::vector<double>& signal);
+
+private:
+    size_t m_length = 0;
+    FftPlan m_plan;                                   //!< Комплексный план длины N/2 (чётные N) или N (нечётные N).
+    std::vector<std::complex<double>> m_twiddles;     //!< Множители exp(-2*pi*i*k/N) для k = [0, N/2] (чётные N).
+    std::vector<std::complex<double>> m_buffer;       //!< Рабочий буфер.
+};
+
+/**
+ * @brief fft - быстрое преобразование Фурье последовательности values (выполняется "на месте", без нормировки).
+ *        План преобразования строится на каждый вызов; для многократных преобразований одной длины следует использовать FftPlan.
+ * @param values - преобразуемая последовательность (заменяется результатом преобразования).
+ * @param isInverse - вычислять ли обратное преобразование (с положительным знаком показателя экспоненты).
+ */
+void fft(std::vector<std::complex<double>>& values, const bool isInverse = false);
+
+} // fourier
+
+#endif // FFT_H
@@ -1,78 +1,342 @@
 #include "filter.h"
 
 #include <algorithm>
-#include <map>
+#include <cassert>
+#include <cmath>
+#include <memory>
 #include <utility>
 
+#include "cache.h"
 #include "commons.h"
 #include "dft.h"
-#include "generate.h"
-#include "logger.h"
+#include "oscillator.h"
+#include "simd.h"
 
 namespace
 {
 
-const std::vector<double> makeStandardSignal(const double frequency, const size_t length)
+/**
+ * @brief kFrequencyQuantum - шаг квантования множителя частоты в ключах кэшей эталонных сигналов.
+ */
+const double kFrequencyQuantum = 1.0e-9;
+
+/**
+ * @brief kStandardCacheBytesLimit - бюджет каждого из кэшей эталонных сигналов и спектров (в байтах).
+ */
+const size_t kStandardCacheBytesLimit = 64 * 1024 * 1024;
+
+/**
+ * @brief StandardKey - ключ кэша эталонных сигналов: квантованный множитель частоты и длина сигнала.
+ */
+using StandardKey = std::pair<long long, size_t>;
+
+using StandardSignalsCache = cache::LruCache<StandardKey, std::vector<double>>;
+using StandardSpectrumsCache = cache::LruCache<StandardKey, std::vector<std::complex<double>>>;
+
+StandardSignalsCache& standardSignalsCache()
+{
+    static StandardSignalsCache signalsCache(kStandardCacheBytesLimit);
+    return signalsCache;
+}
+
+StandardSpectrumsCache& standardSpectrumsCache()
 {
-    static std::map<std::pair<double, size_t>, std::vector<double>> standardSignalsCache;
+    static StandardSpectrumsCache spectrumsCache(kStandardCacheBytesLimit);
+    return spectrumsCache;
+}
 
-    auto founded = standardSignalsCache.find({ frequency, length });
-    if (founded == std::end(standardSignalsCache))
+/**
+ * @brief makeStandardSignal - возвращает эталонный сигнал частоты frequency длины length (из кэша).
+ */
+std::shared_ptr<const std::vector<double>> makeStandardSignal(const double frequency, const size_t length)
+{
+    const StandardKey kKey{ cache::quantize(frequency, kFrequencyQuantum), length };
+    return standardSignalsCache().get(kKey, [frequency, length]()
     {
-        const SineSignal sine{ { frequency, 0.0 }, std::vector<SineBehaviour>(length, { SineBehaviour::kVolumeMax, true }) };
+        std::vector<double> signalValues(length, 0.0);
+        oscillator::addSine(signalValues, 0, frequency, 0.0, SineBehaviour::kVolumeMax);
+        return signalValues;
+    });
+}
 
-        std::vector<double> signalValues;
-        signalValues.reserve(length);
+/**
+ * @brief makeStandardSpectrum - возвращает половину спектра эталонного сигнала частоты frequency длины plan.size() (из кэша).
+ * @param plan - план преобразования, используемый при отсутствии спектра в кэше.
+ */
+std::shared_ptr<const std::vector<std::complex<double>>> makeStandardSpectrum(const double frequency,
+                                                                               fourier::RealFftPlan& plan)
+{
+    const size_t kLength = plan.size();
+    const StandardKey kKey{ cache::quantize(frequency, kFrequencyQuantum), kLength };
+    return standardSpectrumsCache().get(kKey, [frequency, kLength, &plan]()
+    {
+        return fourier::realDft(*::makeStandardSignal(frequency, kLength), plan);
+    });
+}
 
-        for (size_t index = 0; index < length; ++index)
-        {
-            signalValues.push_back(sineSignalValue(sine, index));
-        }
+/**
+ * @brief makeStandardSpectrum - то же, но план преобразования строится только при отсутствии спектра в кэше.
+ */
+std::shared_ptr<const std::vector<std::complex<double>>> makeStandardSpectrum(const double frequency, const size_t length)
+{
+    const StandardKey kKey{ cache::quantize(frequency, kFrequencyQuantum), length };
+    return standardSpectrumsCache().get(kKey, [frequency, length]()
+    {
+        fourier::RealFftPlan plan(length);
+        return fourier::realDft(*::makeStandardSignal(frequency, length), plan);
+    });
+}
 
-        auto inserted = standardSignalsCache.insert({ { frequency, length }, signalValues });
-        if (inserted.second)
-        {
-            founded = inserted.first;
-        }
-        else
-        {
-            Logger::error(  "Unexpected error: can't insert value in signals cache: "
-                            "{ frequency = " + std::to_string(frequency)
-                          + ", length = " + std::to_string(length)
-                          + " }.");
-            return std::vector<double>();
-        }
+/**
+ * @brief spectrumBin - возвращает отсчёт index полного спектра действительного сигнала длины length,
+ *        заданного неотрицательной половиной halfSpectrum (отсчёты выше N/2 достраиваются по эрмитовой симметрии).
+ */
+std::complex<double> spectrumBin(const std::vector<std::complex<double>>& halfSpectrum,
+                                 const size_t length,
+                                 const size_t index)
+{
+    return (index < halfSpectrum.size() ? halfSpectrum[index]
+                                        : std::conj(halfSpectrum[length - index]));
+}
+
+/**
+ * @brief phasor - возвращает exp(-2*pi*i*(bin*index mod length)/length).
+ *        Показатель приводится по модулю length в целых числах, поэтому точность не падает с ростом index.
+ */
+std::complex<double> phasor(const size_t bin, const size_t index, const size_t length)
+{
+    const size_t kResidue = static_cast<size_t>((static_cast<unsigned long long>(bin % length) * (index % length)) % length);
+    return std::polar(1.0, -2.0 * M_PI * static_cast<double>(kResidue) / static_cast<double>(length));
+}
+
+/**
+ * @brief binSum - вычисляет сумму(signal[m] * exp(-2*pi*i*bin*m/length), m = [first, last)) - вклад отрезка сигнала
+ *        в отсчёт bin ненормированного спектра длины length.
+ */
+std::complex<double> binSum(Span<const double> signal,
+                            const size_t first,
+                            const size_t last,
+                            const size_t bin,
+                            const size_t length)
+{
+    std::complex<double> sum(0.0, 0.0);
+    for (size_t m = first; m < last; ++m)
+    {
+        sum += signal[m] * ::phasor(bin, m, length);
     }
+    return sum;
+}
 
-    return founded->second;
+/**
+ * @brief standardBin - возвращает отсчёт bin спектра эталонного сигнала частоты frequency длины length.
+ */
+std::complex<double> standardBin(const double frequency, const size_t length, const size_t bin)
+{
+    return ::spectrumBin(*::makeStandardSpectrum(frequency, length), length, bin);
 }
 
-const std::vector<std::complex<double>> makeStandardSpectrum(const double frequency,
-                                                             const std::vector<double> signal)
+/**
+ * @struct FilterBankSetup
+ * @brief Неизменяемые параметры банка детекторов (см. slidingFilterBank), общие для всех потоков.
+ *        Параметры частот хранятся структурой массивов.
+ */
+struct FilterBankSetup
 {
-    static std::map<std::pair<double, size_t>, std::vector<std::complex<double>>> standardSpectrumsCache;
+    size_t count = 0;                    //!< Количество частот.
+    size_t maxWindowsCount = 0;          //!< Наибольшее количество положений окна среди всех частот.
+    size_t maxHop = 1;                   //!< Наибольший шаг положений окна среди всех частот.
+    size_t blockLength = 1;              //!< Длина блока положений окна: в начале каждого блока суммы окон пересчитываются точно.
+    std::vector<size_t> widths;          //!< Ширина окна.
+    std::vector<size_t> bins;            //!< Индекс отсчёта спектра.
+    std::vector<size_t> expandedLengths; //!< Длина окна после дополнения нулями.
+    std::vector<size_t> windowsCounts;   //!< Количество положений окна.
+    std::vector<size_t> hops;            //!< Шаг положений окна: модули отсчёта усредняются по hops[i] соседним положениям.
+    std::vector<double> magnitudeScales; //!< Множитель модуля: |S[bin]| / E.
+    std::vector<double> stepRe;          //!< Поворот множителей p при сдвиге окна на один отсчёт.
+    std::vector<double> stepIm;
+};
 
-    const size_t kLength = signal.size();
+/**
+ * @struct FilterBankState
+ * @brief Изменяемое состояние резонаторов банка детекторов (рабочий буфер одного потока).
+ */
+struct FilterBankState
+{
+    std::vector<double> leavingRe, leavingIm;   //!< Множитель p для покидающего окно отсчёта.
+    std::vector<double> enteringRe, enteringIm; //!< Множитель p для входящего в окно отсчёта.
+    std::vector<double> sumRe, sumIm;           //!< Сумма окна A(t).
+    std::vector<size_t> nextAnchors;            //!< Положение окна следующего точного пересчёта.
+    std::vector<size_t> enteringIndexes;        //!< Индексы входящих в окна отсчётов.
+    std::vector<double> hopSums;                //!< Сумма модулей отсчёта на текущем интервале шага.
+
+    explicit FilterBankState(const size_t count) :
+        leavingRe(count), leavingIm(count),
+        enteringRe(count), enteringIm(count),
+        sumRe(count), sumIm(count),
+        nextAnchors(count),
+        enteringIndexes(count),
+        hopSums(count)
+    { }
+};
+
+const FilterBankSetup makeFilterBankSetup(Span<const double> compositeSignal,
+                                          const std::vector<double>& frequencies,
+                                          const std::vector<size_t>& windowWidths,
+                                          const std::vector<size_t>& expandedLengths,
+                                          const std::vector<size_t>& hops)
+{
+    assert(frequencies.size() == windowWidths.size());
+    assert(frequencies.size() == expandedLengths.size());
+    assert(frequencies.size() == hops.size());
+
+    const size_t kLength = compositeSignal.size();
+
+    FilterBankSetup result;
+    if (kLength == 0)
+    {
+        return result;
+    }
+
+    result.count = frequencies.size();
+    result.widths.resize(result.count);
+    result.bins.resize(result.count);
+    result.expandedLengths = expandedLengths;
+    result.windowsCounts.resize(result.count);
+    result.hops = hops;
+    result.magnitudeScales.resize(result.count);
+    result.stepRe.resize(result.count);
+    result.stepIm.resize(result.count);
+
+    for (size_t f = 0; f < result.count; ++f)
+    {
+        result.widths[f] = std::min(windowWidths[f], kLength);
+        assert(result.widths[f] > 0 && result.widths[f] <= expandedLengths[f]);
+        assert(hops[f] > 0);
+        result.maxHop = std::max(result.maxHop, hops[f]);
+
+        result.bins[f] = frequencyToIndex(frequencies[f], expandedLengths[f]);
+        result.windowsCounts[f] = kLength - result.widths[f] + 1;
+        result.maxWindowsCount = std::max(result.maxWindowsCount, result.windowsCounts[f]);
+
+        // Модуль отсчёта свёртки: |A(t)| * |S[bin]| / E (фазовый множитель окна на модуль не влияет).
+        result.magnitudeScales[f] = modulus(::standardBin(frequencies[f], expandedLengths[f], result.bins[f]))
+                                  / static_cast<double>(expandedLengths[f]);
+
+        const std::complex<double> step = ::phasor(result.bins[f], 1, expandedLengths[f]);
+        result.stepRe[f] = step.real();
+        result.stepIm[f] = step.imag();
+    }
+
+    // Точный пересчёт стоит O(W) на частоту, поэтому блок берётся в несколько раз длиннее наибольшего окна.
+    const size_t kMaxWidth = (result.count == 0 ? 0 : *std::max_element(std::begin(result.widths), std::end(result.widths)));
+    result.blockLength = std::max<size_t>(8 * kMaxWidth, 1024);
+
+    return result;
+}
+
+/**
+ * @brief makeFilterBankTracks - выделяет память под результаты банка детекторов setup:
+ *        по одному значению на каждое положение окна, кратное шагу частоты.
+ */
+std::vector<std::vector<double>> makeFilterBankTracks(const FilterBankSetup& setup)
+{
+    std::vector<std::vector<double>> result(setup.count);
+    for (size_t f = 0; f < setup.count; ++f)
+    {
+        result[f].resize((setup.windowsCounts[f] + setup.hops[f] - 1) / setup.hops[f]);
+    }
+    return result;
+}
 
-    auto founded = standardSpectrumsCache.find({ frequency, kLength });
-    if (founded == std::end(standardSpectrumsCache))
+/**
+ * @brief scanFilterBank - вычисляет модули отсчётов банка детекторов setup и записывает в result[f][k]
+ *        их среднее по интервалу положений окна [k * hop, (k + 1) * hop) для интервалов, начинающихся в [first, last).
+ *        Усреднение перед прореживанием исключает наложение (aliasing) пульсаций модуля.
+ *        Интервалы, начатые внутри фрагмента, досчитываются за его пределами, поэтому каждый элемент result
+ *        записывается ровно одним фрагментом.
+ *        Суммы окон пересчитываются точно в положениях, кратных ширине окна или setup.blockLength, - независимо от границ
+ *        фрагмента. Поэтому фрагменты, начинающиеся на границе блока (first кратно setup.blockLength), можно обрабатывать
+ *        независимо (в разных потоках со своими state), а результат не зависит от разбиения на фрагменты.
+ */
+void scanFilterBank(Span<const double> compositeSignal,
+                    const FilterBankSetup& setup,
+                    const size_t first,
+                    const size_t last,
+                    FilterBankState& state,
+                    std::vector<std::vector<double>>& result)
+{
+    const size_t kLength = compositeSignal.size();
+    const size_t kCount = setup.count;
+    assert(first % setup.blockLength == 0);
+    std::fill(std::begin(state.nextAnchors), std::end(state.nextAnchors), first);
+
+    const size_t kScanLast = std::min(last + setup.maxHop - 1, setup.maxWindowsCount);
+    const double* const kSignal = compositeSignal.data();
+    for (size_t t = first; t < kScanLast; ++t)
     {
-        auto inserted = standardSpectrumsCache.insert({ { frequency, kLength }, fourier::dft(signal) });
-        if (inserted.second)
+        if (t > first)
         {
-            founded = inserted.first;
+            const double kLeaving = kSignal[t - 1];
+            for (size_t f = 0; f < kCount; ++f)
+            {
+                // Для завершившихся треков индекс ограничивается концом сигнала, их значения далее не используются.
+                state.enteringIndexes[f] = std::min(t - 1 + setup.widths[f], kLength - 1);
+            }
+            for (size_t f = 0; f < kCount; ++f)
+            {
+                const double kEntering = kSignal[state.enteringIndexes[f]];
+                state.sumRe[f] += kEntering * state.enteringRe[f] - kLeaving * state.leavingRe[f];
+                state.sumIm[f] += kEntering * state.enteringIm[f] - kLeaving * state.leavingIm[f];
+
+                const double kLeavingRe = state.leavingRe[f] * setup.stepRe[f] - state.leavingIm[f] * setup.stepIm[f];
+                state.leavingIm[f] = state.leavingRe[f] * setup.stepIm[f] + state.leavingIm[f] * setup.stepRe[f];
+                state.leavingRe[f] = kLeavingRe;
+
+                const double kEnteringRe = state.enteringRe[f] * setup.stepRe[f] - state.enteringIm[f] * setup.stepIm[f];
+                state.enteringIm[f] = state.enteringRe[f] * setup.stepIm[f] + state.enteringIm[f] * setup.stepRe[f];
+                state.enteringRe[f] = kEnteringRe;
+            }
         }
-        else
+
+        for (size_t f = 0; f < kCount; ++f)
         {
-            Logger::error(  "Unexpected error: can't insert value in spectrums cache: "
-                            "{ frequency = " + std::to_string(frequency)
-                          + ", length = " + std::to_string(kLength)
-                          + " }.");
-            return std::vector<std::complex<double>>();
+            if (t >= setup.windowsCounts[f])
+            {
+                continue;
+            }
+
+            if (t == state.nextAnchors[f])
+            {
+                // Точный пересчёт суммы окна и поворачивающих множителей (см. slidingFilterByFrequency).
+                const std::complex<double> sum = ::binSum(compositeSignal, t, t + setup.widths[f], setup.bins[f], setup.expandedLengths[f]);
+                const std::complex<double> leaving = ::phasor(setup.bins[f], t, setup.expandedLengths[f]);
+                const std::complex<double> entering = ::phasor(setup.bins[f], t + setup.widths[f], setup.expandedLengths[f]);
+                state.sumRe[f] = sum.real();
+                state.sumIm[f] = sum.imag();
+                state.leavingRe[f] = leaving.real();
+                state.leavingIm[f] = leaving.imag();
+                state.enteringRe[f] = entering.real();
+                state.enteringIm[f] = entering.imag();
+                state.nextAnchors[f] = std::min((t / setup.widths[f] + 1) * setup.widths[f],
+                                                (t / setup.blockLength + 1) * setup.blockLength);
+            }
+
+            const size_t kHop = setup.hops[f];
+            const size_t kOffset = t % kHop;
+            const size_t kIntervalFirst = t - kOffset;
+            if (kIntervalFirst < first || kIntervalFirst >= last)
+            {
+                continue;
+            }
+
+            const double kMagnitude = setup.magnitudeScales[f] * std::sqrt(sqr(state.sumRe[f]) + sqr(state.sumIm[f]));
+            state.hopSums[f] = (kOffset == 0 ? kMagnitude : state.hopSums[f] + kMagnitude);
+            if (kOffset + 1 == kHop || t + 1 == setup.windowsCounts[f])
+            {
+                result[f][t / kHop] = state.hopSums[f] / static_cast<double>(kOffset + 1);
+            }
         }
     }
-
-    return founded->second;
 }
 
 enum class FilterType
@@ -81,14 +345,19 @@ enum class FilterType
     HighPass
 };
 
+/**
+ * @brief makeSincSpectrum - возвращает половину (length/2+1 отсчётов) спектра идеального фильтра нижних или верхних частот
+ *        для сигнала длины length. Спектр фильтра симметричен, поэтому половины достаточно для фильтрации действительного сигнала.
+ */
 const std::vector<std::complex<double>> makeSincSpectrum(const double frequency, const size_t length, FilterType type)
 {
-    std::vector<std::complex<double>> result(length, {0.0, 0.0});
+    const size_t kHalfLength = length / 2 + 1;
+    std::vector<std::complex<double>> result(kHalfLength, {0.0, 0.0});
 
     const size_t cutoffLowerIndex = frequencyToIndex(frequency, length);
     const size_t cutoffUpperIndex = length - cutoffLowerIndex;
 
-    for (size_t i = 0; i < length; ++i)
+    for (size_t i = 0; i < kHalfLength; ++i)
     {
         switch (type)
         {
@@ -114,70 +383,237 @@ const std::vector<std::complex<double>> makeSincSpectrum(const double frequency,
 
 }
 
-const std::vector<double> filterByFrequency(const std::vector<double>& compositeSignal,
+const std::vector<double> filterByFrequency(Span<const double> compositeSignal,
+                                            const double frequency,
+                                            std::vector<std::complex<double>>* spectrum)
+{
+    fourier::RealFftPlan plan(compositeSignal.size());
+    return filterByFrequency(compositeSignal, frequency, plan, spectrum);
+}
+
+const std::vector<double> filterByFrequency(Span<const double> compositeSignal,
                                             const double frequency,
+                                            fourier::RealFftPlan& plan,
                                             std::vector<std::complex<double>>* spectrum)
 {
     const size_t kLength = compositeSignal.size();
 
-    const std::vector<double> standardSignal = ::makeStandardSignal(frequency, kLength);
-    const std::vector<std::complex<double>> standardSignalSpectrum = ::makeStandardSpectrum(frequency, standardSignal);
+    const std::vector<std::complex<double>> convolutionSpectrum = filteredSpectrum(compositeSignal, frequency, plan);
 
-    const std::vector<std::complex<double>> compositeSignalSpectrum = fourier::dft(compositeSignal);
+    if (spectrum != nullptr)
+    {
+        // Полный спектр достраивается из половины по эрмитовой симметрии.
+        spectrum->assign(std::begin(convolutionSpectrum), std::end(convolutionSpectrum));
+        spectrum->resize(kLength);
+        for (size_t k = convolutionSpectrum.size(); k < kLength; ++k)
+        {
+            (*spectrum)[k] = std::conj(convolutionSpectrum[kLength - k]);
+        }
+    }
 
-    std::vector<std::complex<double>> convolutionSpectrum(kLength, { 0.0, 0.0 });
-    std::transform(std::begin(compositeSignalSpectrum),
-                   std::end(compositeSignalSpectrum),
-                   std::begin(standardSignalSpectrum),
-                   std::begin(convolutionSpectrum),
-                   [](const std::complex<double>& eachComposite,
-                      const std::complex<double>& eachStandard)
-                   { return (eachComposite * eachStandard); });
+    return fourier::inverseRealDft(convolutionSpectrum, plan);
+}
 
-    if (spectrum != nullptr)
+const std::vector<std::complex<double>> filteredSpectrum(Span<const double> compositeSignal,
+                                                         const double frequency)
+{
+    fourier::RealFftPlan plan(compositeSignal.size());
+    return filteredSpectrum(compositeSignal, frequency, plan);
+}
+
+const std::vector<std::complex<double>> filteredSpectrum(Span<const double> compositeSignal,
+                                                         const double frequency,
+                                                         fourier::RealFftPlan& plan)
+{
+    std::vector<std::complex<double>> convolutionSpectrum;
+    filteredSpectrum(compositeSignal, frequency, plan, convolutionSpectrum);
+    return convolutionSpectrum;
+}
+
+void filteredSpectrum(Span<const double> compositeSignal,
+                      const double frequency,
+                      fourier::RealFftPlan& plan,
+                      std::vector<std::complex<double>>& spectrum)
+{
+    const auto kStandardSignalSpectrum = ::makeStandardSpectrum(frequency, plan);
+
+    // Спектр свёртки вычисляется на месте спектра сложного сигнала.
+    fourier::realDft(compositeSignal, plan, spectrum);
+    simd::multiply(spectrum.data(),
+                   kStandardSignalSpectrum->data(),
+                   spectrum.data(),
+                   spectrum.size());
+}
+
+std::complex<double> filteredBin(Span<const double> compositeSignal,
+                                 const double frequency,
+                                 const size_t index)
+{
+    const size_t kLength = compositeSignal.size();
+    assert(index < kLength);
+
+    const std::complex<double> compositeBin = ::binSum(compositeSignal, 0, kLength, index, kLength) / static_cast<double>(kLength);
+    return (compositeBin * ::standardBin(frequency, kLength, index));
+}
+
+const std::vector<std::complex<double>> filteredBins(Span<const double> compositeSignal,
+                                                     const double frequency,
+                                                     const std::vector<size_t>& indexes)
+{
+    std::vector<std::complex<double>> result;
+    result.reserve(indexes.size());
+    for (const size_t each : indexes)
     {
-        *spectrum = convolutionSpectrum;
+        result.push_back(filteredBin(compositeSignal, frequency, each));
     }
+    return result;
+}
 
-    return fourier::inverseDft(convolutionSpectrum);
+const std::vector<std::complex<double>> slidingFilterByFrequency(Span<const double> compositeSignal,
+                                                                 const double frequency,
+                                                                 const size_t windowWidth,
+                                                                 const size_t expandedLength)
+{
+    const size_t kLength = compositeSignal.size();
+    const size_t kWidth = std::min(windowWidth, kLength);
+    assert(kWidth <= expandedLength);
+
+    std::vector<std::complex<double>> result;
+    if (kWidth == 0 || expandedLength == 0)
+    {
+        return result;
+    }
+
+    const size_t kBin = frequencyToIndex(frequency, expandedLength);
+
+    // Отсчёт спектра эталонного сигнала одинаков для всех окон.
+    const std::complex<double> standardBin = ::standardBin(frequency, expandedLength, kBin);
+    const double kScale = 1.0 / static_cast<double>(expandedLength);
+
+    // Отсчёт спектра окна [t, t+W), дополненного нулями до длины E:
+    //     X(t) = exp(+i*w*t) * A(t) / E,  A(t) = sum(x[m] * exp(-i*w*m), m = [t, t+W)),  w = 2*pi*bin/E.
+    // Сумма A(t) обновляется при сдвиге окна за O(1): A(t+1) = A(t) - x[t]*p[t] + x[t+W]*p[t+W].
+    // Для ограничения накопления ошибок округления A(t) и поворачивающие множители p пересчитываются
+    // заново на каждом W-м сдвиге, что сохраняет амортизированную сложность O(1) на сдвиг.
+    const size_t kWindowsCount = kLength - kWidth + 1;
+    result.resize(kWindowsCount);
+
+    const std::complex<double> kStep = ::phasor(kBin, 1, expandedLength);
+    std::complex<double> sum(0.0, 0.0);
+    std::complex<double> leaving(1.0, 0.0);
+    std::complex<double> entering(1.0, 0.0);
+    for (size_t t = 0; t < kWindowsCount; ++t)
+    {
+        if (t % kWidth == 0)
+        {
+            sum = ::binSum(compositeSignal, t, t + kWidth, kBin, expandedLength);
+            leaving = ::phasor(kBin, t, expandedLength);
+            entering = ::phasor(kBin, t + kWidth, expandedLength);
+        }
+        else
+        {
+            sum += compositeSignal[t - 1 + kWidth] * entering - compositeSignal[t - 1] * leaving;
+            leaving *= kStep;
+            entering *= kStep;
+        }
+
+        result[t] = std::conj(leaving) * sum * kScale * standardBin;
+    }
+
+    return result;
 }
 
-const std::vector<double> lowPassFilterByFrequency(const std::vector<double>& signal,
+const std::vector<std::vector<double>> slidingFilterBank(Span<const double> compositeSignal,
+                                                         const std::vector<double>& frequencies,
+                                                         const std::vector<size_t>& windowWidths,
+                                                         const std::vector<size_t>& expandedLengths)
+{
+    const std::vector<size_t> kHops(frequencies.size(), 1);
+    const FilterBankSetup setup = ::makeFilterBankSetup(compositeSignal, frequencies, windowWidths, expandedLengths, kHops);
+    std::vector<std::vector<double>> result = ::makeFilterBankTracks(setup);
+
+    FilterBankState state(setup.count);
+    ::scanFilterBank(compositeSignal, setup, 0, setup.maxWindowsCount, state, result);
+
+    return result;
+}
+
+const std::vector<std::vector<double>> slidingFilterBank(Span<const double> compositeSignal,
+                                                         const std::vector<double>& frequencies,
+                                                         const std::vector<size_t>& windowWidths,
+                                                         const std::vector<size_t>& expandedLengths,
+                                                         ThreadPool& pool)
+{
+    return slidingFilterBank(compositeSignal, frequencies, windowWidths, expandedLengths,
+                             std::vector<size_t>(frequencies.size(), 1), pool);
+}
+
+const std::vector<std::vector<double>> slidingFilterBank(Span<const double> compositeSignal,
+                                                         const std::vector<double>& frequencies,
+                                                         const std::vector<size_t>& windowWidths,
+                                                         const std::vector<size_t>& expandedLengths,
+                                                         const std::vector<size_t>& hops,
+                                                         ThreadPool& pool)
+{
+    const FilterBankSetup setup = ::makeFilterBankSetup(compositeSignal, frequencies, windowWidths, expandedLengths, hops);
+    std::vector<std::vector<double>> result = ::makeFilterBankTracks(setup);
+
+    std::vector<FilterBankState> states;
+    states.reserve(pool.size());
+    for (size_t i = 0; i < pool.size(); ++i)
+    {
+        states.emplace_back(setup.count);
+    }
+
+    // Диапазон делится на фрагменты (и перехватывается) целыми блоками, поэтому фрагменты начинаются на границах блоков.
+    const size_t kBlocksCount = (setup.maxWindowsCount + setup.blockLength - 1) / setup.blockLength;
+    pool.parallelFor(kBlocksCount,
+                     1,
+                     [&](const size_t firstBlock, const size_t lastBlock, const size_t worker)
+                     {
+                         ::scanFilterBank(compositeSignal, setup,
+                                          firstBlock * setup.blockLength,
+                                          std::min(lastBlock * setup.blockLength, setup.maxWindowsCount),
+                                          states[worker], result);
+                     });
+
+    return result;
+}
+
+const std::vector<double> lowPassFilterByFrequency(Span<const double> signal,
                                                    const double frequency)
 {
     const size_t kLength = signal.size();
 
     const std::vector<std::complex<double>> sincSpectrum = ::makeSincSpectrum(frequency, kLength, FilterType::LowPass);
-    const std::vector<std::complex<double>> signalSpectrum = fourier::dft(signal);
+    const std::vector<std::complex<double>> signalSpectrum = fourier::realDft(signal);
 
-    std::vector<std::complex<double>> convolutionSpectrum(kLength, { 0.0, 0.0 });
-    std::transform(std::begin(signalSpectrum),
-                   std::end(signalSpectrum),
-                   std::begin(sincSpectrum),
-                   std::begin(convolutionSpectrum),
-                   [](const std::complex<double>& eachSignal,
-                      const std::complex<double>& eachSinc)
-                   { return (eachSignal * eachSinc); });
+    std::vector<std::complex<double>> convolutionSpectrum(signalSpectrum.size(), { 0.0, 0.0 });
+    simd::multiply(signalSpectrum.data(), sincSpectrum.data(), convolutionSpectrum.data(), convolutionSpectrum.size());
 
-    return fourier::inverseDft(convolutionSpectrum);
+    return fourier::inverseRealDft(convolutionSpectrum, kLength);
 }
 
-const std::vector<double> highPassFilterByFrequency(const std::vector<double>& signal,
+const std::vector<double> highPassFilterByFrequency(Span<const double> signal,
                                                    const double frequency)
 {
     const size_t kLength = signal.size();
 
     const std::vector<std::complex<double>> sincSpectrum = ::makeSincSpectrum(frequency, kLength, FilterType::HighPass);
-    const std::vector<std::complex<double>> signalSpectrum = fourier::dft(signal);
-
-    std::vector<std::complex<double>> convolutionSpectrum(kLength, { 0.0, 0.0 });
-    std::transform(std::begin(signalSpectrum),
-                   std::end(signalSpectrum),
-                   std::begin(sincSpectrum),
-                   std::begin(convolutionSpectrum),
-                   [](const std::complex<double>& eachSignal,
-                      const std::complex<double>& eachSinc)
-                   { return (eachSignal * eachSinc); });
-
-    return fourier::inverseDft(convolutionSpectrum);
+    const std::vector<std::complex<double>> signalSpectrum = fourier::realDft(signal);
+
+    std::vector<std::complex<double>> convolutionSpectrum(signalSpectrum.size(), { 0.0, 0.0 });
+    simd::multiply(signalSpectrum.data(), sincSpectrum.data(), convolutionSpectrum.data(), convolutionSpectrum.size());
+
+    return fourier::inverseRealDft(convolutionSpectrum, kLength);
+}
+
+cache::Statistics standardSignalsCacheStatistics()
+{
+    return ::standardSignalsCache().statistics();
+}
+
+cache::Statistics standardSpectrumsCacheStatistics()
+{
+    return ::standardSpectrumsCache().statistics();
 }
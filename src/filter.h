@@ -4,6 +4,11 @@
 #include <complex>
 #include <vector>
 
+#include "cache.h"
+#include "fft.h"
+#include "span.h"
+#include "threadpool.h"
+
 /**
  * @brief filterByFrequency - выделяет из сложного сигнала compositeSignal базовую составляющую,
  *        соответствующую частоте frequency (используя свёртку сигналов).
@@ -12,14 +17,171 @@
  * @param spectrum [optional] - спектр выделенного базового сигнала.
  * @return набор дискретных отсчётов выделенного базового сигнала.
  */
-const std::vector<double> filterByFrequency(const std::vector<double>& compositeSignal,
+const std::vector<double> filterByFrequency(Span<const double> compositeSignal,
+                                            const double frequency,
+                                            std::vector<std::complex<double>>* spectrum = nullptr);
+
+/**
+ * @brief filterByFrequency - выделяет из сложного сигнала compositeSignal базовую составляющую,
+ *        соответствующую частоте frequency, используя заранее построенный план преобразования plan.
+ *        Предназначен для многократной фильтрации сигналов одинаковой длины.
+ * @param compositeSignal - сложный сигнал, полученный наложением нескольких базовых синусоидальных составляющих.
+ * @param frequency - множитель частоты выделяемой составляющей.
+ * @param plan - план преобразования длины compositeSignal.size().
+ * @param spectrum [optional] - спектр выделенного базового сигнала.
+ * @return набор дискретных отсчётов выделенного базового сигнала.
+ */
+const std::vector<double> filterByFrequency(Span<const double> compositeSignal,
                                             const double frequency,
+                                            fourier::RealFftPlan& plan,
                                             std::vector<std::complex<double>>* spectrum = nullptr);
 
-const std::vector<double> lowPassFilterByFrequency(const std::vector<double>& signal,
+/**
+ * @brief filteredSpectrum - вычисляет только спектр базовой составляющей сложного сигнала compositeSignal,
+ *        соответствующей частоте frequency (без обратного преобразования, в отличие от filterByFrequency).
+ * @param compositeSignal - сложный сигнал, полученный наложением нескольких базовых синусоидальных составляющих.
+ * @param frequency - множитель частоты выделяемой составляющей.
+ * @return неотрицательная половина спектра выделенной составляющей (compositeSignal.size()/2+1 отсчётов, см. fourier::realDft).
+ */
+const std::vector<std::complex<double>> filteredSpectrum(Span<const double> compositeSignal,
+                                                         const double frequency);
+
+/**
+ * @brief filteredSpectrum - вычисляет только спектр базовой составляющей сложного сигнала compositeSignal,
+ *        используя заранее построенный план преобразования plan.
+ * @param compositeSignal - сложный сигнал.
+ * @param frequency - множитель частоты выделяемой составляющей.
+ * @param plan - план преобразования длины compositeSignal.size().
+ * @return неотрицательная половина спектра выделенной составляющей.
+ */
+const std::vector<std::complex<double>> filteredSpectrum(Span<const double> compositeSignal,
+                                                         const double frequency,
+                                                         fourier::RealFftPlan& plan);
+
+/**
+ * @brief filteredSpectrum - вычисляет спектр базовой составляющей сложного сигнала compositeSignal
+ *        с записью результата в буфер spectrum, предоставленный вызывающей стороной
+ *        (при повторных вызовах для сигналов одной длины память не выделяется).
+ * @param compositeSignal - сложный сигнал.
+ * @param frequency - множитель частоты выделяемой составляющей.
+ * @param plan - план преобразования длины compositeSignal.size().
+ * @param spectrum - неотрицательная половина спектра выделенной составляющей.
+ */
+void filteredSpectrum(Span<const double> compositeSignal,
+                      const double frequency,
+                      fourier::RealFftPlan& plan,
+                      std::vector<std::complex<double>>& spectrum);
+
+/**
+ * @brief filteredBin - вычисляет один отсчёт index спектра базовой составляющей сложного сигнала compositeSignal,
+ *        соответствующей частоте frequency. Отсчёт вычисляется прямым суммированием за O(N), без преобразования всего сигнала.
+ * @param compositeSignal - сложный сигнал.
+ * @param frequency - множитель частоты выделяемой составляющей.
+ * @param index - индекс отсчёта полного спектра (в диапазоне [0, compositeSignal.size())).
+ * @return значение отсчёта спектра (совпадает с отсчётом index спектра, возвращаемого filterByFrequency).
+ */
+std::complex<double> filteredBin(Span<const double> compositeSignal,
+                                 const double frequency,
+                                 const size_t index);
+
+/**
+ * @brief filteredBins - вычисляет набор отсчётов indexes спектра базовой составляющей (см. filteredBin).
+ * @param compositeSignal - сложный сигнал.
+ * @param frequency - множитель частоты выделяемой составляющей.
+ * @param indexes - индексы отсчётов полного спектра.
+ * @return значения отсчётов спектра в порядке indexes.
+ */
+const std::vector<std::complex<double>> filteredBins(Span<const double> compositeSignal,
+                                                     const double frequency,
+                                                     const std::vector<size_t>& indexes);
+
+/**
+ * @brief slidingFilterByFrequency - детектор составляющей с частотой frequency в скользящем окне.
+ *        Для каждого положения окна шириной windowWidth (окна сдвигаются на один отсчёт, начиная с начала сигнала)
+ *        вычисляет отсчёт frequencyToIndex(frequency, expandedLength) спектра, который вернула бы функция filterByFrequency
+ *        для окна, дополненного нулями до длины expandedLength. Вместо полного прямого и обратного преобразования
+ *        для каждого окна отсчёт обновляется рекурсивно (скользящее ДПФ), за O(1) на сдвиг окна.
+ *        Если сигнал короче окна, вычисляется единственное значение для всего сигнала.
+ * @param compositeSignal - сложный сигнал, полученный наложением нескольких базовых синусоидальных составляющих.
+ * @param frequency - множитель частоты выделяемой составляющей.
+ * @param windowWidth - ширина окна.
+ * @param expandedLength - длина окна после дополнения нулями (не меньше ширины окна).
+ * @return значения отсчёта спектра выделенной составляющей для каждого положения окна (compositeSignal.size() - windowWidth + 1 значений).
+ */
+const std::vector<std::complex<double>> slidingFilterByFrequency(Span<const double> compositeSignal,
+                                                                 const double frequency,
+                                                                 const size_t windowWidth,
+                                                                 const size_t expandedLength);
+
+/**
+ * @brief slidingFilterBank - банк детекторов для набора частот frequencies: то же, что slidingFilterByFrequency
+ *        для каждой частоты, но за один проход по сигналу. На каждом отсчёте обновляются резонаторы всех частот,
+ *        состояние которых хранится структурой массивов (обновление векторизуется по частотам).
+ * @param compositeSignal - сложный сигнал, полученный наложением нескольких базовых синусоидальных составляющих.
+ * @param frequencies - множители частот выделяемых составляющих.
+ * @param windowWidths - ширина окна для каждой частоты.
+ * @param expandedLengths - длина окна после дополнения нулями для каждой частоты.
+ * @return для каждой частоты - модули отсчёта спектра выделенной составляющей для каждого положения окна
+ *         (compositeSignal.size() - windowWidths[i] + 1 значений).
+ */
+const std::vector<std::vector<double>> slidingFilterBank(Span<const double> compositeSignal,
+                                                         const std::vector<double>& frequencies,
+                                                         const std::vector<size_t>& windowWidths,
+                                                         const std::vector<size_t>& expandedLengths);
+
+/**
+ * @brief slidingFilterBank - параллельный вариант банка детекторов: положения окна делятся на фрагменты,
+ *        которые распределяются между потоками пула pool с перехватом работы (work stealing).
+ *        Фрагменты состоят из целых блоков положений окна, в начале которых суммы окон пересчитываются точно
+ *        (как и в последовательном варианте), а результаты записываются непосредственно по индексу положения окна,
+ *        поэтому результат не зависит от количества потоков и порядка обработки фрагментов.
+ * @param compositeSignal - сложный сигнал.
+ * @param frequencies - множители частот выделяемых составляющих.
+ * @param windowWidths - ширина окна для каждой частоты.
+ * @param expandedLengths - длина окна после дополнения нулями для каждой частоты.
+ * @param pool - пул потоков.
+ * @return то же (с точностью до бита), что и последовательный вариант slidingFilterBank.
+ */
+const std::vector<std::vector<double>> slidingFilterBank(Span<const double> compositeSignal,
+                                                         const std::vector<double>& frequencies,
+                                                         const std::vector<size_t>& windowWidths,
+                                                         const std::vector<size_t>& expandedLengths,
+                                                         ThreadPool& pool);
+
+/**
+ * @brief slidingFilterBank - параллельный банк детекторов с шагом положений окна hops[i] для каждой частоты:
+ *        резонаторы по-прежнему сдвигаются на каждый отсчёт, но сохраняется одно значение на интервал шага -
+ *        среднее модулей отсчёта по положениям окна [k * hops[i], (k + 1) * hops[i]) (без наложения пульсаций модуля).
+ * @param compositeSignal - сложный сигнал.
+ * @param frequencies - множители частот выделяемых составляющих.
+ * @param windowWidths - ширина окна для каждой частоты.
+ * @param expandedLengths - длина окна после дополнения нулями для каждой частоты.
+ * @param hops - шаг положений окна для каждой частоты (не менее 1).
+ * @param pool - пул потоков.
+ * @return для каждой частоты - средние модули отсчёта по интервалам шага
+ *         (ceil((compositeSignal.size() - windowWidths[i] + 1) / hops[i]) значений).
+ */
+const std::vector<std::vector<double>> slidingFilterBank(Span<const double> compositeSignal,
+                                                         const std::vector<double>& frequencies,
+                                                         const std::vector<size_t>& windowWidths,
+                                                         const std::vector<size_t>& expandedLengths,
+                                                         const std::vector<size_t>& hops,
+                                                         ThreadPool& pool);
+
+const std::vector<double> lowPassFilterByFrequency(Span<const double> signal,
                                                    const double frequency);
 
-const std::vector<double> highPassFilterByFrequency(const std::vector<double>& signal,
+const std::vector<double> highPassFilterByFrequency(Span<const double> signal,
                                                     const double frequency);
 
+/**
+ * @brief standardSignalsCacheStatistics - счётчики кэша эталонных сигналов, используемых для фильтрации.
+ */
+cache::Statistics standardSignalsCacheStatistics();
+
+/**
+ * @brief standardSpectrumsCacheStatistics - счётчики кэша спектров эталонных сигналов.
+ */
+cache::Statistics standardSpectrumsCacheStatistics();
+
 #endif // FILTER_H
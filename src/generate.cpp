@@ -3,70 +3,218 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
-#include <random>
+#include <functional>
+#include <limits>
+
+#include "oscillator.h"
 
 namespace
 {
 /**
- * @brief randomNoiseLevel - возвращает случайное значение уровня шума.
- * @return уровень шума (в диапазоне от 0 до +/- 15%).
+ * @brief kNoiseLevelMin, kNoiseLevelMax - диапазон уровня шума (относительно максимальной амплитуды сигнала).
+ */
+const double kNoiseLevelMin = -0.15;
+const double kNoiseLevelMax =  0.15;
+
+/**
+ * @brief kChunkLength - длина фрагмента сигнала, формируемого одной задачей. Разбиение на фрагменты не зависит
+ *        от количества потоков, поэтому от него не зависит и результат.
  */
-double randomNoiseLevel()
+const size_t kChunkLength = 64 * 1024;
+
+/**
+ * @brief kGoldenGamma - приращение счётчика генератора SplitMix64.
+ */
+const uint64_t kGoldenGamma = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief mix - перемешивающая функция генератора SplitMix64.
+ */
+uint64_t mix(uint64_t value)
 {
-    static const double kNoiseLevelMin = -0.15;
-    static const double kNoiseLevelMax =  0.15;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
 
-    static std::default_random_engine generator;
-    static std::uniform_real_distribution<double> distribution(kNoiseLevelMin, kNoiseLevelMax);
+/**
+ * @brief randomNoiseLevel - возвращает случайное значение уровня шума для отсчёта index.
+ *        Генератор на основе счётчика: значение - (index + 1)-е значение последовательности SplitMix64
+ *        с начальным значением seed, вычисленное без перебора предыдущих (не зависит от порядка и потока вычисления).
+ * @return уровень шума (в диапазоне от 0 до +/- 15%).
+ */
+double randomNoiseLevel(const uint64_t seed, const size_t index)
+{
+    const uint64_t kRandom = ::mix(seed + (static_cast<uint64_t>(index) + 1) * kGoldenGamma);
 
-    return distribution(generator);
+    // Старшие 53 бита - равномерно распределённое значение из [0, 1).
+    const double kUniform = static_cast<double>(kRandom >> 11) / static_cast<double>(1ULL << 53);
+    return kNoiseLevelMin + (kNoiseLevelMax - kNoiseLevelMin) * kUniform;
 }
 
 /**
  * @brief addNoise - добавляет к значению value случайный шум в диапазоне +/- 0-15% от maxValue.
  * @param value - исходное значение.
  * @param maxValue - максимальная амплитуда значения.
+ * @param seed - начальное значение генератора шума.
+ * @param index - индекс отсчёта.
  * @return "зашумлённое" значение value.
  */
-double addNoise(const double value, const double maxValue)
+double addNoise(const double value, const double maxValue, const uint64_t seed, const size_t index)
 {
-    const double noise = maxValue * randomNoiseLevel();
+    const double noise = maxValue * randomNoiseLevel(seed, index);
 
     return (value + noise);
 }
 
+/**
+ * @struct ValuesRange
+ * @brief Наименьшее и наибольшее значения фрагмента сигнала.
+ */
+struct ValuesRange
+{
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief renderChunk - формирует фрагмент chunk сигнала result из базовых сигналов baseSignals
+ *        (каждый базовый сигнал добавляется отрезками с неизменной громкостью, см. oscillator::addSine)
+ *        и определяет диапазон значений фрагмента, пока они находятся в кэше.
+ */
+ValuesRange renderChunk(const size_t chunk,
+                        const std::vector<SineSignal>& baseSignals,
+                        std::vector<double>& result)
+{
+    const size_t kFirst = chunk * kChunkLength;
+    const size_t kLast = std::min(kFirst + kChunkLength, result.size());
+
+    for (const SineSignal& each : baseSignals)
+    {
+        const SineOption& currentSine = each.sine;
+        for (auto segment = each.behaviour.segmentAt(kFirst);
+             segment != std::end(each.behaviour) && segment->start < kLast;
+             ++segment)
+        {
+            if (!segment->behaviour.enabled)
+            {
+                continue;
+            }
+
+            const size_t kStart = std::max(segment->start, kFirst);
+            const size_t kEnd = std::min(segment->start + segment->length, kLast);
+            oscillator::addSine(Span<double>(result.data() + kStart, kEnd - kStart),
+                                kStart,
+                                currentSine.freqFactor,
+                                currentSine.startPhase,
+                                segment->behaviour.volumeLevel);
+        }
+    }
+
+    ValuesRange range;
+    for (size_t index = kFirst; index < kLast; ++index)
+    {
+        range.min = std::min(range.min, result[index]);
+        range.max = std::max(range.max, result[index]);
+    }
+    return range;
 }
 
-const std::vector<double> generate(const size_t signalLength,
-                                   const std::vector<SineSignal>& baseSignals,
-                                   bool noiseEnabled)
+/**
+ * @brief addChunkNoise - добавляет шум к значениям фрагмента chunk сигнала result.
+ */
+void addChunkNoise(const size_t chunk,
+                   const double maxAmplitude,
+                   const uint64_t seed,
+                   std::vector<double>& result)
+{
+    const size_t kFirst = chunk * kChunkLength;
+    const size_t kLast = std::min(kFirst + kChunkLength, result.size());
+    for (size_t index = kFirst; index < kLast; ++index)
+    {
+        result[index] = ::addNoise(result[index], maxAmplitude, seed, index);
+    }
+}
+
+/**
+ * @brief generateByChunks - генерирует сигнал фрагментами; forEachChunk(count, body) вызывает body(chunk)
+ *        для каждого фрагмента из [0, count) (последовательно или в потоках пула).
+ */
+template <typename ForEachChunk>
+const std::vector<double> generateByChunks(const size_t signalLength,
+                                           const std::vector<SineSignal>& baseSignals,
+                                           const GenerateOptions& options,
+                                           ForEachChunk forEachChunk)
 {
     assert(signalLength > 0);
 
     const double kDefaultValue = 0.0;
     std::vector<double> result(signalLength, kDefaultValue);
 
-    for (size_t currentIndex = 0; currentIndex < signalLength; ++currentIndex)
+    const size_t kChunksCount = (signalLength + kChunkLength - 1) / kChunkLength;
+    std::vector<ValuesRange> ranges(kChunksCount);
+    forEachChunk(kChunksCount, [&](const size_t chunk) { ranges[chunk] = ::renderChunk(chunk, baseSignals, result); });
+
+    if (options.noiseEnabled)
     {
-        for (const SineSignal& each : baseSignals)
+        // Уровень шума зависит от наибольшей амплитуды всего сигнала, поэтому шум добавляется вторым проходом.
+        double maxAmplitude = 0.0;
+        for (const ValuesRange& each : ranges)
         {
-            result[currentIndex] += sineSignalValue(each, currentIndex);
+            maxAmplitude = std::max({ maxAmplitude, std::abs(each.min), std::abs(each.max) });
         }
+
+        forEachChunk(kChunksCount, [&](const size_t chunk) { ::addChunkNoise(chunk, maxAmplitude, options.seed, result); });
     }
 
-    if (noiseEnabled)
+    return result;
+}
+
+}
+
+const std::vector<double> generate(const size_t signalLength,
+                                   const std::vector<SineSignal>& baseSignals,
+                                   bool noiseEnabled)
+{
+    GenerateOptions options;
+    options.noiseEnabled = noiseEnabled;
+    return generate(signalLength, baseSignals, options);
+}
+
+const std::vector<double> generate(const size_t signalLength,
+                                   const std::vector<SineSignal>& baseSignals,
+                                   const GenerateOptions& options)
+{
+    if (options.threadsCount == 1)
     {
-        const auto minmax = std::minmax_element(std::begin(result),
-                                                std::end(result));
-        const double maxAmplitude = std::max(std::abs(*minmax.first),
-                                             std::abs(*minmax.second));
-        for (double& each : result)
-        {
-            each = ::addNoise(each, maxAmplitude);
-        }
+        return ::generateByChunks(signalLength,
+                                  baseSignals,
+                                  options,
+                                  [](const size_t count, const std::function<void(size_t)>& body)
+                                  {
+                                      for (size_t chunk = 0; chunk < count; ++chunk)
+                                      {
+                                          body(chunk);
+                                      }
+                                  });
     }
 
-    return result;
+    ThreadPool pool(options.threadsCount);
+    return generate(signalLength, baseSignals, options, pool);
+}
+
+const std::vector<double> generate(const size_t signalLength,
+                                   const std::vector<SineSignal>& baseSignals,
+                                   const GenerateOptions& options,
+                                   ThreadPool& pool)
+{
+    return ::generateByChunks(signalLength,
+                              baseSignals,
+                              options,
+                              [&pool](const size_t count, const std::function<void(size_t)>& body)
+                              {
+                                  pool.run(count, body);
+                              });
 }
 
 double sineSignalValue(const SineSignal& signal, const size_t index)
@@ -77,7 +225,7 @@ double sineSignalValue(const SineSignal& signal, const size_t index)
     }
 
     const SineOption& currentSine = signal.sine;
-    const SineBehaviour& currentBehaviour = signal.behaviour.at(index);
+    const SineBehaviour& currentBehaviour = signal.behaviour.segmentAt(index)->behaviour;
 
     return (  (currentBehaviour.enabled ? 1 : 0)
             * currentBehaviour.volumeLevel
@@ -2,9 +2,27 @@
 #define GENERATE_H
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "commons.h"
+#include "threadpool.h"
+
+/**
+ * @brief kDefaultNoiseSeed - начальное значение генератора шума по умолчанию.
+ */
+const uint64_t kDefaultNoiseSeed = 0x5EEDULL;
+
+/**
+ * @struct GenerateOptions
+ * @brief Параметры генерации сигнала.
+ */
+struct GenerateOptions
+{
+    bool noiseEnabled = false;         //!< Добавлять ли случайный шум (в пределах 0%-15% максимальной амплитуды сигнала).
+    uint64_t seed = kDefaultNoiseSeed; //!< Начальное значение генератора шума.
+    size_t threadsCount = 1;           //!< Количество потоков (0 - по количеству ядер процессора).
+};
 
 /**
  * @brief generate - генерирует сигнал длиной signalLength из набора базовых сигналов,
@@ -18,6 +36,29 @@ const std::vector<double> generate(const size_t signalLength,
                                    const std::vector<SineSignal>& baseSignals,
                                    bool noiseEnabled = false);
 
+/**
+ * @brief generate - генерирует сигнал длиной signalLength из набора базовых сигналов baseSignals
+ *        согласно параметрам options. Сигнал формируется фрагментами фиксированной длины (в options.threadsCount потоках);
+ *        шум каждого отсчёта определяется начальным значением options.seed и индексом отсчёта
+ *        (генератор на основе счётчика), поэтому результат не зависит от количества потоков.
+ * @param signalLength - длина результирующего сигнала (количество его дискретных значений).
+ * @param baseSignals - параметры синусоидальных базовых сигналов.
+ * @param options - параметры генерации.
+ * @return набор значений результирующего сигнала.
+ */
+const std::vector<double> generate(const size_t signalLength,
+                                   const std::vector<SineSignal>& baseSignals,
+                                   const GenerateOptions& options);
+
+/**
+ * @brief generate - генерирует сигнал с использованием пула потоков pool (options.threadsCount не используется).
+ *        Результат совпадает с результатом последовательной генерации с теми же параметрами.
+ */
+const std::vector<double> generate(const size_t signalLength,
+                                   const std::vector<SineSignal>& baseSignals,
+                                   const GenerateOptions& options,
+                                   ThreadPool& pool);
+
 /**
  * @brief sineSignalValue - возвращает значение амплитуды базового сигнала с характеристиками signal
  *        в момент времени, определённый значением index.
@@ -1,55 +1,325 @@
 #include "logger.h"
 
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <ctime>
-#include <fstream>
-#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "csvwriter.h"
 
 namespace
 {
+/**
+ * @brief kQueueCapacity - количество сообщений в кольцевой очереди (степень двойки).
+ *        При заполнении очереди производители ожидают вывода сообщений.
+ */
+const size_t kQueueCapacity = 4096;
+
+/**
+ * @brief gLevel - порог уровня выводимых сообщений.
+ */
+std::atomic<int> gLevel{ static_cast<int>(LogLevel::Trace) };
+
+const char* levelTitle(const LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Trace:
+        return " TRACE: ";
+    case LogLevel::Debug:
+        return " DEBUG: ";
+    case LogLevel::Info:
+        return " INFO:  ";
+    case LogLevel::Warning:
+        return " WARN:  ";
+    default:
+        return " ERROR: ";
+    }
+}
 
-const std::tm currentTime()
+/**
+ * @class LogQueue
+ * @brief Ограниченная кольцевая очередь сообщений (алгоритм D. Vyukov): производители занимают ячейки
+ *        сравнением с обменом позиции записи, готовность ячейки определяется её порядковым номером.
+ *        Единственный потребитель - фоновый поток, выводящий сообщения пакетами.
+ *        Потребитель засыпает на условной переменной, только если очередь пуста; производители будят его,
+ *        лишь когда он спит, поэтому в обычном режиме запись сообщения не требует блокировок.
+ */
+class LogQueue
 {
-    using namespace std::chrono;
+public:
+    LogQueue() :
+        m_slots(new Slot[kQueueCapacity])
+    {
+        using namespace std::chrono;
+
+        // Время сообщений - показание steady_clock (дешевле и монотонно), местное время вычисляется по смещению.
+        m_wallClockOffset = duration_cast<system_clock::duration>(system_clock::now().time_since_epoch()
+                                                                 - steady_clock::now().time_since_epoch());
+        for (size_t i = 0; i < kQueueCapacity; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_writer = std::thread(&LogQueue::writerLoop, this);
+    }
+
+    ~LogQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopping = true;
+        }
+        m_changed.notify_all();
+        m_writer.join();
+    }
+
+    LogQueue(const LogQueue&) = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+
+    void push(const LogLevel level, std::string message)
+    {
+        const std::chrono::steady_clock::time_point kTime = std::chrono::steady_clock::now();
+
+        size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true)
+        {
+            slot = &m_slots[position & (kQueueCapacity - 1)];
+            const size_t kSequence = slot->sequence.load(std::memory_order_acquire);
+            if (kSequence == position)
+            {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (kSequence < position)
+            {
+                // Очередь заполнена: ожидание вывода сообщений.
+                wake();
+                std::this_thread::yield();
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->level = level;
+        slot->time = kTime;
+        slot->message = std::move(message);
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_isSleeping.load(std::memory_order_relaxed))
+        {
+            wake();
+        }
+    }
+
+    /**
+     * @brief flush - ожидает вывода сообщений, помещённых в очередь до вызова.
+     */
+    void flush()
+    {
+        const size_t kTarget = m_enqueuePosition.load(std::memory_order_acquire);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_written.wait(lock, [this, kTarget]() { return (m_writtenCount >= kTarget || m_isStopping); });
+    }
+
+private:
+    /**
+     * @struct Slot
+     * @brief Ячейка очереди: sequence == позиция записи - ячейка свободна, позиция + 1 - содержит сообщение.
+     */
+    struct Slot
+    {
+        std::atomic<size_t> sequence{ 0 };
+        LogLevel level = LogLevel::Trace;
+        std::chrono::steady_clock::time_point time;
+        std::string message;
+    };
+
+    void wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+        }
+        m_changed.notify_one();
+    }
+
+    bool isEmpty() const
+    {
+        const Slot& slot = m_slots[m_dequeuePosition & (kQueueCapacity - 1)];
+        return (slot.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1);
+    }
+
+    /**
+     * @brief appendRecords - добавляет к тексту text все готовые сообщения очереди.
+     */
+    void appendRecords(std::string& text)
+    {
+        while (!isEmpty())
+        {
+            Slot& slot = m_slots[m_dequeuePosition & (kQueueCapacity - 1)];
+            appendTime(slot.time, text);
+            text += levelTitle(slot.level);
+            text += slot.message;
+            text += '\n';
+
+            slot.message.clear();
+            slot.sequence.store(m_dequeuePosition + kQueueCapacity, std::memory_order_release);
+            ++m_dequeuePosition;
+        }
+    }
+
+    /**
+     * @brief appendTime - добавляет к тексту text местное время time в формате "ЧЧ:ММ:СС"
+     *        (преобразование выполняется один раз в секунду).
+     */
+    void appendTime(const std::chrono::steady_clock::time_point time, std::string& text)
+    {
+        using namespace std::chrono;
 
-    const time_t now = system_clock::to_time_t(system_clock::now());
-    std::tm result = *std::localtime(&now);
+        const time_t kSeconds = system_clock::to_time_t(system_clock::time_point(
+            duration_cast<system_clock::duration>(time.time_since_epoch()) + m_wallClockOffset));
+        if (kSeconds != m_formattedSeconds || m_formattedTime.empty())
+        {
+            std::tm local;
+#if defined(_WIN32)
+            localtime_s(&local, &kSeconds);
+#else
+            localtime_r(&kSeconds, &local);
+#endif
+            char buffer[16];
+            const size_t kLength = std::strftime(buffer, sizeof(buffer), "%H:%M:%S", &local);
+            m_formattedTime.assign(buffer, kLength);
+            m_formattedSeconds = kSeconds;
+        }
+        text += m_formattedTime;
+    }
+
+    void writerLoop()
+    {
+        std::string text;
+        while (true)
+        {
+            appendRecords(text);
+            if (!text.empty())
+            {
+                std::cout << text << std::flush;
+                text.clear();
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_writtenCount = m_dequeuePosition;
+            m_written.notify_all();
+
+            m_isSleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_changed.wait(lock, [this]() { return (!isEmpty() || m_isStopping); });
+            m_isSleeping.store(false, std::memory_order_relaxed);
+
+            if (m_isStopping && isEmpty())
+            {
+                break;
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<size_t> m_enqueuePosition{ 0 };
+    size_t m_dequeuePosition = 0;                    //!< Позиция чтения (только фоновый поток).
+
+    std::chrono::system_clock::duration m_wallClockOffset;
+    time_t m_formattedSeconds = 0;
+    std::string m_formattedTime;
 
-    return result;
+    std::mutex m_mutex;
+    std::condition_variable m_changed;               //!< Появление сообщений или завершение.
+    std::condition_variable m_written;               //!< Вывод очередного пакета сообщений.
+    std::atomic<bool> m_isSleeping{ false };
+    size_t m_writtenCount = 0;
+    bool m_isStopping = false;
+    std::thread m_writer;
+};
+
+LogQueue& logQueue()
+{
+    static LogQueue queue;
+    return queue;
 }
 
 }
 
 void Logger::trace(const std::string& message)
 {
-    const std::tm tm = ::currentTime();
-    std::cout << std::put_time(&tm, "%H:%M:%S") << " TRACE: " << message << std::endl;
+    write(LogLevel::Trace, message);
 }
 
 void Logger::debug(const std::string& message)
 {
-    const std::tm tm = ::currentTime();
-    std::cout << std::put_time(&tm, "%H:%M:%S") << " DEBUG: " << message << std::endl;
+    write(LogLevel::Debug, message);
 }
 
 void Logger::info(const std::string& message)
 {
-    const std::tm tm = ::currentTime();
-    std::cout << std::put_time(&tm, "%H:%M:%S") << " INFO:  " << message << std::endl;
+    write(LogLevel::Info, message);
 }
 
 void Logger::warning(const std::string& message)
 {
-    const std::tm tm = ::currentTime();
-    std::cout << std::put_time(&tm, "%H:%M:%S") << " WARN:  " << message << std::endl;
+    write(LogLevel::Warning, message);
 }
 
 void Logger::error(const std::string& message)
 {
-    const std::tm tm = ::currentTime();
-    std::cout << std::put_time(&tm, "%H:%M:%S") << " ERROR: " << message << std::endl;
+    write(LogLevel::Error, message);
+}
+
+void Logger::write(const LogLevel level, std::string message)
+{
+    if (!isEnabled(level))
+    {
+        return;
+    }
+
+    ::logQueue().push(level, std::move(message));
+    if (level >= LogLevel::Error)
+    {
+        ::logQueue().flush();
+    }
+}
+
+void Logger::setLevel(const LogLevel level)
+{
+    gLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+LogLevel Logger::level()
+{
+    return static_cast<LogLevel>(gLevel.load(std::memory_order_relaxed));
+}
+
+bool Logger::isEnabled(const LogLevel level)
+{
+    return (level != LogLevel::Off
+            && static_cast<int>(level) >= FOURIER_LOG_MIN_LEVEL
+            && static_cast<int>(level) >= gLevel.load(std::memory_order_relaxed));
+}
+
+void Logger::flush()
+{
+    ::logQueue().flush();
 }
 
 void writeValuesToCsv(const std::string& fileName,
@@ -57,44 +327,24 @@ void writeValuesToCsv(const std::string& fileName,
                       const size_t linesCount,
                       const std::vector<std::vector<double>>& columns)
 {
-    std::ofstream out(fileName);
+    // Форматирование значений и запись на диск выполняются одновременно.
+    CsvWriterOptions options;
+    options.isBackground = true;
+
+    CsvWriter out(fileName, options);
     if (!out.good())
     {
         Logger::error(strerror(errno));
         return;
     }
 
-    bool isFirstColumn = true;
-    for (const std::string& eachTitle : titles)
-    {
-        if (!isFirstColumn)
-            out << ", ";
-        else
-            isFirstColumn = false;
-
-        out << eachTitle;
-    }
-    out << std::endl;
-
-    for (size_t i = 0; i < linesCount; ++i)
+    out.writeRow(titles);
+    out.writeColumns(columns, 0, linesCount);
+    out.flush();
+    if (!out.good())
     {
-        if (!out)
-        {
-            Logger::error(strerror(errno));
-            return;
-        }
-
-        isFirstColumn = true;
-        for (const std::vector<double>& eachColumn : columns)
-        {
-            if (!isFirstColumn)
-                out << ", ";
-            else
-                isFirstColumn = false;
-
-            out << (eachColumn.size() > i ? std::to_string(eachColumn.at(i)) : "");
-        }
-        out << std::endl;
+        Logger::error(strerror(errno));
+        return;
     }
 
     Logger::info("Writed " + fileName);
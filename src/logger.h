@@ -4,9 +4,39 @@
 #include <string>
 #include <vector>
 
+/**
+ * @brief FOURIER_LOG_MIN_LEVEL - наименьший уровень выводимых сообщений (значение LogLevel), задаётся при сборке
+ *        (параметр CMake FOURIER_LOG_MIN_LEVEL). Вызовы макросов LOG_* более низкого уровня вместе с формированием
+ *        текста сообщения удаляются компилятором; сообщения методов Logger отбрасываются при вызове.
+ */
+#ifndef FOURIER_LOG_MIN_LEVEL
+#define FOURIER_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @brief LogLevel - уровень важности сообщения.
+ */
+enum class LogLevel
+{
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warning = 3,
+    Error = 4,
+    Off = 5     //!< Порог, отключающий все сообщения.
+};
+
 /**
  * @class Logger
  * @brief Реализует единый механизм логгирования.
+ *        Сообщения не ниже порога level() помещаются в кольцевую очередь без блокировок (несколько производителей,
+ *        один потребитель) и выводятся в std::cout фоновым потоком, поэтому логгирование безопасно из любых потоков
+ *        и не ожидает вывода. Время сообщения - показание steady_clock, пересчитываемое фоновым потоком
+ *        в местное время по смещению, вычисленному при запуске.
+ *        Сообщения уровня Error выводятся до возврата из вызова (см. flush).
+ *
+ * @note Для сообщений, текст которых вычисляется, следует использовать макросы LOG_TRACE ... LOG_ERROR:
+ *       текст не формируется, если уровень ниже порога.
  */
 class Logger
 {
@@ -17,10 +47,50 @@ public:
     static void warning(const std::string& message);
     static void error(const std::string& message);
 
+    /**
+     * @brief write - помещает в очередь сообщение message уровня level (если уровень не ниже порога).
+     */
+    static void write(const LogLevel level, std::string message);
+
+    /**
+     * @brief setLevel, level - порог уровня выводимых сообщений (по умолчанию LogLevel::Trace).
+     */
+    static void setLevel(const LogLevel level);
+    static LogLevel level();
+
+    /**
+     * @brief isEnabled - выводятся ли сообщения уровня level.
+     */
+    static bool isEnabled(const LogLevel level);
+
+    /**
+     * @brief flush - ожидает вывода всех помещённых в очередь сообщений.
+     */
+    static void flush();
 };
 
 /**
- * @brief writeValuesToCsv - записывает значения values в csv-файл с именем fileName.
+ * @brief FOURIER_LOG - логгирует сообщение message уровня level; выражение message вычисляется,
+ *        только если уровень не ниже FOURIER_LOG_MIN_LEVEL и порога Logger::level().
+ */
+#define FOURIER_LOG(level, message)                                                       \
+    do                                                                                    \
+    {                                                                                     \
+        if (static_cast<int>(level) >= FOURIER_LOG_MIN_LEVEL && Logger::isEnabled(level)) \
+        {                                                                                 \
+            Logger::write(level, (message));                                              \
+        }                                                                                 \
+    } while (false)
+
+#define LOG_TRACE(message) FOURIER_LOG(LogLevel::Trace, message)
+#define LOG_DEBUG(message) FOURIER_LOG(LogLevel::Debug, message)
+#define LOG_INFO(message) FOURIER_LOG(LogLevel::Info, message)
+#define LOG_WARNING(message) FOURIER_LOG(LogLevel::Warning, message)
+#define LOG_ERROR(message) FOURIER_LOG(LogLevel::Error, message)
+
+/**
+ * @brief writeValuesToCsv - записывает значения values в csv-файл с именем fileName
+ *        (значения - в кратчайшем точно восстанавливаемом представлении, см. CsvWriter).
  * @param fileName - имя выходного файла.
  * @param titles - список заголовков столбцов данных.
  * @param linesCount - количество записываемых строк данных.
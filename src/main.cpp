@@ -1,12 +1,19 @@
+#include "columnar.h"
 #include "commons.h"
 #include "decompose.h"
 #include "dft.h"
 #include "filter.h"
 #include "generate.h"
 #include "logger.h"
+#include "signalreader.h"
+#include "streamingdecomposer.h"
 
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace
@@ -38,13 +45,18 @@ const std::vector<double> baseSignalValues(const SineSignal& signal,
     std::vector<double> result;
     result.reserve(kLength);
 
-    for (size_t index = 0; index < kLength; ++index)
+    for (const BehaviourSegment& segment : signal.behaviour)
     {
         if (signalEnables != nullptr)
         {
-            signalEnables->push_back(static_cast<double>(signal.behaviour.at(index).enabled ? SignalState::On : SignalState::Off));
+            signalEnables->insert(std::end(*signalEnables),
+                                  segment.length,
+                                  static_cast<double>(segment.behaviour.enabled ? SignalState::On : SignalState::Off));
+        }
+        for (size_t index = segment.start; index < segment.start + segment.length; ++index)
+        {
+            result.push_back(sineSignalValue(signal, index));
         }
-        result.push_back(sineSignalValue(signal, index));
     }
 
     return result;
@@ -75,24 +87,24 @@ const std::vector<SineSignal> makeBaseSignals(const size_t signalLength,
     size_t period = frequencyToPeriod(first.sine.freqFactor);
     size_t offset = (signalLength > (period / 2)) ? (period / 2) : 0;
 
-    auto itEnd = std::end(first.behaviour);
-    auto itFirst = std::begin(first.behaviour) + offset;
-    auto itLast = (signalLength >= (9 * period + offset)) ? std::begin(first.behaviour) + (9 * period + offset)
-                                                          : itEnd;
+    size_t indexEnd = signalLength;
+    size_t indexFirst = offset;
+    size_t indexLast = (signalLength >= (9 * period + offset)) ? (9 * period + offset)
+                                                               : indexEnd;
     double volume = 0.5;
     do
     {
-        std::fill(itFirst, itLast, SineBehaviour{ volume, true });
+        first.behaviour.fill(indexFirst, indexLast, SineBehaviour{ volume, true });
         volume += 0.5;
         if (volume > SineBehaviour::kVolumeMax)
         {
             volume = 0.5;
         }
-        itFirst = (std::distance(itFirst, itEnd) > static_cast<int>(15 * period)) ? (itFirst + (15 * period))
-                                                                                  : itLast;
-        itLast = (std::distance(itLast, itEnd) > static_cast<int>(15 * period)) ? (itLast + (15 * period))
-                                                                                : itEnd;
-    } while (itLast != itEnd);
+        indexFirst = (indexEnd - indexFirst > 15 * period) ? (indexFirst + 15 * period)
+                                                           : indexLast;
+        indexLast = (indexEnd - indexLast > 15 * period) ? (indexLast + 15 * period)
+                                                         : indexEnd;
+    } while (indexLast != indexEnd);
 
     // Вторая составляющая сложного сигнала:
     SineSignal& second = result[1];
@@ -102,24 +114,23 @@ const std::vector<SineSignal> makeBaseSignals(const size_t signalLength,
     period = frequencyToPeriod(second.sine.freqFactor);
     offset = (signalLength > (3 * period / 2)) ? (3 * period / 2) : 0;
 
-    itEnd = std::end(second.behaviour);
-    itFirst = std::begin(second.behaviour) + offset;
-    itLast = (signalLength >= (15 * period / 2 + offset)) ? std::begin(second.behaviour) + (15 * period / 2 + offset)
-                                                          : itEnd;
+    indexFirst = offset;
+    indexLast = (signalLength >= (15 * period / 2 + offset)) ? (15 * period / 2 + offset)
+                                                             : indexEnd;
     volume = SineBehaviour::kVolumeMax;
     do
     {
-        std::fill(itFirst, itLast, SineBehaviour{ volume, true });
+        second.behaviour.fill(indexFirst, indexLast, SineBehaviour{ volume, true });
         volume -= 2.0 * SineBehaviour::kVolumeMin;
         if (volume < SineBehaviour::kVolumeMin)
         {
             volume = SineBehaviour::kVolumeMax;
         }
-        itFirst = (std::distance(itFirst, itEnd) > static_cast<int>(13 * period)) ? (itFirst + (13 * period))
-                                                                                  : itLast;
-        itLast = (std::distance(itLast, itEnd) > static_cast<int>(13 * period)) ? (itLast + (13 * period))
-                                                                                : itEnd;
-    } while (itLast != itEnd);
+        indexFirst = (indexEnd - indexFirst > 13 * period) ? (indexFirst + 13 * period)
+                                                           : indexLast;
+        indexLast = (indexEnd - indexLast > 13 * period) ? (indexLast + 13 * period)
+                                                         : indexEnd;
+    } while (indexLast != indexEnd);
 
     // Третья составляющая сложного сигнала:
     SineSignal& third = result[2];
@@ -129,20 +140,19 @@ const std::vector<SineSignal> makeBaseSignals(const size_t signalLength,
     period = frequencyToPeriod(third.sine.freqFactor);
     offset = (signalLength > (period / 3)) ? (period / 3) : 0;
 
-    itEnd = std::end(third.behaviour);
-    itFirst = std::begin(third.behaviour) + offset;
-    itLast = (signalLength >= (5 * period + offset)) ? std::begin(third.behaviour) + (5 * period + offset)
-                                                     : itEnd;
+    indexFirst = offset;
+    indexLast = (signalLength >= (5 * period + offset)) ? (5 * period + offset)
+                                                        : indexEnd;
     volume = SineBehaviour::kVolumeMax;
     do
     {
-        std::fill(itFirst, itLast, SineBehaviour{ volume, true });
+        third.behaviour.fill(indexFirst, indexLast, SineBehaviour{ volume, true });
 
-        itFirst = (std::distance(itFirst, itEnd) > static_cast<int>(10 * period)) ? (itFirst + (10 * period))
-                                                                                  : itLast;
-        itLast = (std::distance(itLast, itEnd) > static_cast<int>(10 * period)) ? (itLast + (10 * period))
-                                                                                : itEnd;
-    } while (itLast != itEnd);
+        indexFirst = (indexEnd - indexFirst > 10 * period) ? (indexFirst + 10 * period)
+                                                           : indexLast;
+        indexLast = (indexEnd - indexLast > 10 * period) ? (indexLast + 10 * period)
+                                                         : indexEnd;
+    } while (indexLast != indexEnd);
 
     // Четвёртая составляющая сложного сигнала:
     SineSignal& fourth = result[3];
@@ -152,10 +162,8 @@ const std::vector<SineSignal> makeBaseSignals(const size_t signalLength,
     period = frequencyToPeriod(fourth.sine.freqFactor);
     offset = 0;
 
-    itFirst = std::begin(fourth.behaviour) + offset;
-    itLast = std::end(fourth.behaviour);
     volume = SineBehaviour::kVolumeMin;
-    std::fill(itFirst, itLast, SineBehaviour{ volume, true });
+    fourth.behaviour.fill(offset, indexEnd, SineBehaviour{ volume, true });
 
     frequencies.push_back(first.sine.freqFactor);
     frequencies.push_back(second.sine.freqFactor);
@@ -165,6 +173,241 @@ const std::vector<SineSignal> makeBaseSignals(const size_t signalLength,
     return result;
 }
 
+/**
+ * @brief kUsage - описание параметров запуска программы.
+ */
+const char kUsage[] =
+    "Usage: fourier [options] [signal-file frequency...]\n"
+    "Without a signal file a generated signal is analysed.\n"
+    "Signal file formats (by extension): .csv, .f32, .f64, .s16 (raw little-endian samples).\n"
+    "Options:\n"
+    "  --stream            decompose the signal by chunks (files larger than memory)\n"
+    "  --column=<n|name>   csv column with the signal values (default 0)\n"
+    "  --separator=<c>     csv column separator (default ',')\n"
+    "  --channels=<n>      interleaved channels count of a raw file (default 1)\n"
+    "  --channel=<n>       channel to analyse (default 0)\n"
+    "  --header=<bytes>    raw file header length (default 0)\n"
+    "  --scale=<x>         multiplier of raw samples (default 1.0)\n"
+    "  --log=<level>       trace, debug, info, warning, error or off (default trace)";
+
+/**
+ * @brief kStreamChunkLength - длина фрагментов сигнала при потоковой декомпозиции.
+ */
+const size_t kStreamChunkLength = 64 * 1024;
+
+/**
+ * @struct Arguments
+ * @brief Параметры запуска программы.
+ */
+struct Arguments
+{
+    std::string signalFileName;      //!< Файл записанного сигнала (пусто - анализ сгенерированного сигнала).
+    std::vector<double> frequencies; //!< Частоты базовых сигналов записанного сигнала.
+    SignalReaderOptions reader;      //!< Параметры чтения файла сигнала.
+    bool isStreaming = false;        //!< Потоковая декомпозиция фрагментами сигнала.
+    LogLevel logLevel = LogLevel::Trace;
+    bool isValid = true;
+};
+
+/**
+ * @brief parseNumber, parseSize - разбирают значение параметра text целиком; false, если text - не число.
+ */
+bool parseNumber(const std::string& text, double& value)
+{
+    const char* const kLast = text.data() + text.size();
+    return (!text.empty() && parseDouble(text.data(), kLast, value) == kLast);
+}
+
+bool parseSize(const std::string& text, size_t& value)
+{
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long kValue = std::strtoull(text.c_str(), &end, 10);
+    if (text.empty() || text[0] == '-' || *end != '\0' || errno != 0)
+    {
+        return false;
+    }
+
+    value = static_cast<size_t>(kValue);
+    return true;
+}
+
+/**
+ * @brief parseLogLevel - разбирает имя уровня логгирования text; false, если имя неизвестно.
+ */
+bool parseLogLevel(const std::string& text, LogLevel& level)
+{
+    const std::pair<const char*, LogLevel> kLevels[] =
+    {
+        { "trace", LogLevel::Trace },
+        { "debug", LogLevel::Debug },
+        { "info", LogLevel::Info },
+        { "warning", LogLevel::Warning },
+        { "error", LogLevel::Error },
+        { "off", LogLevel::Off }
+    };
+
+    for (const auto& each : kLevels)
+    {
+        if (text == each.first)
+        {
+            level = each.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief parseArguments - разбирает параметры запуска (см. kUsage); при ошибке isValid = false (ошибка записывается в лог).
+ */
+Arguments parseArguments(const int argc, char* argv[])
+{
+    Arguments result;
+    for (int index = 1; index < argc; ++index)
+    {
+        const std::string kArgument(argv[index]);
+        if (kArgument.compare(0, 2, "--") != 0)
+        {
+            double frequency = 0.0;
+            if (result.signalFileName.empty())
+            {
+                result.signalFileName = kArgument;
+            }
+            else if (::parseNumber(kArgument, frequency) && frequency > 0.0)
+            {
+                result.frequencies.push_back(frequency);
+            }
+            else
+            {
+                Logger::error("Invalid frequency '" + kArgument + "'.");
+                result.isValid = false;
+            }
+            continue;
+        }
+
+        const size_t kEqual = kArgument.find('=');
+        const std::string kName = kArgument.substr(0, kEqual);
+        const std::string kValue = (kEqual != std::string::npos ? kArgument.substr(kEqual + 1) : std::string());
+
+        bool isValid = true;
+        if (kName == "--stream")
+        {
+            result.isStreaming = true;
+        }
+        else if (kName == "--column")
+        {
+            if (!::parseSize(kValue, result.reader.column))
+            {
+                result.reader.columnName = kValue;
+                isValid = !kValue.empty();
+            }
+        }
+        else if (kName == "--separator")
+        {
+            isValid = (kValue.size() == 1);
+            result.reader.separator = (isValid ? kValue[0] : result.reader.separator);
+        }
+        else if (kName == "--channels")
+        {
+            isValid = ::parseSize(kValue, result.reader.channelsCount);
+        }
+        else if (kName == "--channel")
+        {
+            isValid = ::parseSize(kValue, result.reader.channel);
+        }
+        else if (kName == "--header")
+        {
+            isValid = ::parseSize(kValue, result.reader.headerSize);
+        }
+        else if (kName == "--scale")
+        {
+            isValid = ::parseNumber(kValue, result.reader.scale);
+        }
+        else if (kName == "--log")
+        {
+            isValid = ::parseLogLevel(kValue, result.logLevel);
+        }
+        else
+        {
+            isValid = false;
+        }
+
+        if (!isValid)
+        {
+            Logger::error("Invalid option '" + kArgument + "'.");
+            result.isValid = false;
+        }
+    }
+
+    if (!result.signalFileName.empty() && result.frequencies.empty())
+    {
+        Logger::error("Frequencies of the base signals are required to analyse " + result.signalFileName + ".");
+        result.isValid = false;
+    }
+
+    return result;
+}
+
+/**
+ * @brief logDecomposition - логгирует результат разложения waves.
+ */
+void logDecomposition(const WaveDecomposition& waves)
+{
+    Logger::info("Signal decomposition result:");
+    for (size_t index = 0; index < waves.size(); ++index)
+    {
+        Logger::info("Wave #" + std::to_string(index + 1) + ":\n" + waves[index].toString());
+    }
+}
+
+/**
+ * @brief analyseRecordedSignal - разложение записанного сигнала из файла arguments.signalFileName
+ *        на базовые сигналы с частотами arguments.frequencies.
+ * @return код завершения программы.
+ */
+int analyseRecordedSignal(const Arguments& arguments)
+{
+    SignalReader reader(arguments.signalFileName, arguments.reader);
+    if (!reader.isOpen())
+    {
+        return EXIT_FAILURE;
+    }
+
+    WaveDecomposition waves;
+    size_t samplesCount = 0;
+    if (arguments.isStreaming)
+    {
+        // Сигнал читается фрагментами и не хранится целиком: объём памяти не зависит от длины файла.
+        LOG_TRACE("Start streaming decomposition of " + arguments.signalFileName + ".");
+        StreamingDecomposer decomposer(arguments.frequencies,
+                                       [&waves](const Wave& wave) { waves.push_back(wave); });
+        samplesCount = reader.readChunks(kStreamChunkLength, [&decomposer](Span<const double> chunk) { decomposer.push(chunk); });
+        decomposer.finish();
+    }
+    else
+    {
+        LOG_TRACE("Read signal " + arguments.signalFileName + ".");
+        std::vector<double> storage;
+        const Span<const double> kSignal = loadSignal(reader, storage);
+
+        LOG_TRACE("Start decomposition of " + std::to_string(kSignal.size()) + " samples.");
+        DecomposeOptions options;
+        options.threadsCount = ThreadPool::defaultThreadsCount();
+        waves = decompose(kSignal, arguments.frequencies, options);
+        samplesCount = kSignal.size();
+    }
+
+    if (!reader.good())
+    {
+        return EXIT_FAILURE;
+    }
+    LOG_TRACE("Decomposition of " + std::to_string(samplesCount) + " samples finished.");
+
+    ::logDecomposition(waves);
+    return EXIT_SUCCESS;
+}
+
 /*
 const std::vector<SineSignal> makeAloneSineSignal(const size_t signalLength,
                                                   std::vector<double>& frequencies)
@@ -174,12 +417,10 @@ const std::vector<SineSignal> makeAloneSineSignal(const size_t signalLength,
     SineSignal sine
     {
         { frequencies.at(0), 0.0 },
-        std::vector<SineBehaviour>(signalLength, { SineBehaviour::kVolumeMin, true })
+        BehaviourTimeline(signalLength, SineBehaviour{ SineBehaviour::kVolumeMin, true })
     };
 
-    std::fill(sine.behaviour.begin(),
-              sine.behaviour.begin() + sine.behaviour.size()/2,
-              SineBehaviour{ SineBehaviour::kVolumeMin, false });
+    sine.behaviour.fill(0, sine.behaviour.size()/2, SineBehaviour{ SineBehaviour::kVolumeMin, false });
 
     return { sine };
 }
@@ -200,8 +441,18 @@ using SignalSpectrum = std::vector<std::complex<double>>;
 
 int main(int argc, char* argv[])
 {
-    unused(argc);
-    unused(argv);
+    const Arguments kArguments = ::parseArguments(argc, argv);
+    if (!kArguments.isValid)
+    {
+        Logger::info(kUsage);
+        return EXIT_FAILURE;
+    }
+
+    Logger::setLevel(kArguments.logLevel);
+    if (!kArguments.signalFileName.empty())
+    {
+        return ::analyseRecordedSignal(kArguments);
+    }
 
     // Параметры исследования:
     const size_t kSignalLength = 1000; //!< Длина исследуемых отрезков сигналов (в дискретах).
@@ -210,26 +461,26 @@ int main(int argc, char* argv[])
                  + ", add noise = " + (kNoiseEnabled ? "True" : "False") + ".");
 
     // Создание набора базовых сигналов:
-    Logger::trace("Generate base signals.");
+    LOG_TRACE("Generate base signals.");
     std::vector<double> frequencies;
     const std::vector<SineSignal> baseSignals = ::makeBaseSignals(kSignalLength, frequencies); // makeAloneSineSignal(kSignalLength, frequencies);
 
     // Генерация результирующего сигнала из набора базовых:
-    Logger::trace("Generate composite signal.");
+    LOG_TRACE("Generate composite signal.");
     CompositeSignal signal = generate(kSignalLength, baseSignals, kNoiseEnabled);
 
     // Необязательный блок. Нужен лишь для сохранения полученных значений в csv-файлы (например, для построения графиков).
     {
         // Вычисление спектра результирующего сигнала:
-        Logger::trace("Calculating spectrum of composite signal.");
+        LOG_TRACE("Calculating spectrum of composite signal.");
         SignalSpectrum spectrum = fourier::dft(signal);
 
         // Восстановление исходного сигнала по его спектру:
-        Logger::trace("Repairing signal by its spectrum.");
+        LOG_TRACE("Repairing signal by its spectrum.");
         CompositeSignal repaired = fourier::inverseDft(spectrum);
 
         // Запись базовых составляющих сигнала в csv-файлы:
-        Logger::trace("Writing csv files:");
+        LOG_TRACE("Writing csv files:");
         for (const SineSignal& each : baseSignals)
         {
             static size_t index = 0;
@@ -239,31 +490,38 @@ int main(int argc, char* argv[])
             CompositeSignal eachValues = ::baseSignalValues(each, &eachEnables);
             SignalSpectrum eachSpectrum = fourier::dft(eachValues);
 
-            writeValuesToCsv(fileName,
-                             { "on/off", "original", "spectrum" },
-                             kSignalLength,
-                             { eachEnables, eachValues, frequencyResponse(eachSpectrum) });
+            writeValues(fileName,
+                        { "on/off", "original", "spectrum" },
+                        kSignalLength,
+                        { eachEnables, eachValues, frequencyResponse(eachSpectrum) });
         }
 
         // Запись результирующего сигнала, его спектра и восстановленного сигнала в csv-файл:
-        writeValuesToCsv("repaired-signal.csv",
-                         { "original", "spectrum", "repaired" },
-                         kSignalLength,
-                         { signal, frequencyResponse(spectrum), repaired });
+        writeValues("repaired-signal.csv",
+                    { "original", "spectrum", "repaired" },
+                    kSignalLength,
+                    { signal, frequencyResponse(spectrum), repaired });
     }
 
     // Разложение результирующего сигнала на набор базовых:
-    Logger::trace("Start signal decomposition.");
-    WaveDecomposition waves = decompose(signal, frequencies);
-    Logger::trace("Decomposition finished.");
-
-    // Логгирование результата разложения:
-    Logger::info("Signal decomposition result:");
-    for (const Wave& each : waves)
+    LOG_TRACE("Start signal decomposition.");
+    DecomposeOptions options;
+    options.threadsCount = ThreadPool::defaultThreadsCount();
+    WaveDecomposition waves = decompose(signal, frequencies, options);
+    LOG_TRACE("Decomposition finished.");
+
+    for (const auto& each : { std::make_pair(std::string("signals"), standardSignalsCacheStatistics()),
+                              std::make_pair(std::string("spectrums"), standardSpectrumsCacheStatistics()) })
     {
-        static size_t index = 0;
-        Logger::info("Wave #" + std::to_string(++index) + ":\n" + each.toString());
+        LOG_TRACE(  "Standard " + each.first + " cache: hits = " + std::to_string(each.second.hits)
+                  + ", misses = " + std::to_string(each.second.misses)
+                  + ", evictions = " + std::to_string(each.second.evictions)
+                  + ", bytes = " + std::to_string(each.second.bytes)
+                  + " / " + std::to_string(each.second.bytesLimit) + ".");
     }
 
+    // Логгирование результата разложения:
+    ::logDecomposition(waves);
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,160 @@
+#include "mappedfile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include "commons.h"
+#include "logger.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FOURIER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef FOURIER_MMAP
+size_t pageSize()
+{
+    static const size_t kPageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return kPageSize;
+}
+#endif
+}
+
+MappedFile::MappedFile(const std::string& fileName, const Access access) :
+    m_access(access)
+{
+    m_isOpen = (map(fileName) || load(fileName));
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef FOURIER_MMAP
+    if (m_isMapped)
+    {
+        ::munmap(const_cast<unsigned char*>(m_data), m_size);
+    }
+#endif
+}
+
+void MappedFile::consume(const size_t position)
+{
+#ifdef FOURIER_MMAP
+    if (!m_isMapped || m_access != Access::Sequential)
+    {
+        return;
+    }
+
+    // Подсказки передаются крупными частями: следующая часть запрашивается, когда прочитана половина предыдущей.
+    if (position + kReadAheadSize / 2 >= m_prefetchedEnd && m_prefetchedEnd < m_size)
+    {
+        const size_t kFirst = std::max(position, m_prefetchedEnd);
+        m_prefetchedEnd = std::min(m_size, position + kReadAheadSize);
+        advise(kFirst, m_prefetchedEnd, MADV_WILLNEED);
+    }
+
+    // Прочитанные страницы освобождаются, чтобы просмотр большого файла не вытеснял из памяти остальные данные.
+    if (position >= m_releasedEnd + kReadAheadSize)
+    {
+        const size_t kReleased = position / pageSize() * pageSize();
+        advise(m_releasedEnd, kReleased, MADV_DONTNEED);
+        m_releasedEnd = kReleased;
+    }
+#else
+    unused(position);
+#endif
+}
+
+bool MappedFile::map(const std::string& fileName)
+{
+#ifdef FOURIER_MMAP
+    const int kFile = ::open(fileName.c_str(), O_RDONLY);
+    if (kFile < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    if (::fstat(kFile, &status) != 0 || status.st_size <= 0)
+    {
+        ::close(kFile);
+        return false;
+    }
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+    if (m_access == Access::Sequential)
+    {
+        ::posix_fadvise(kFile, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+
+    const size_t kSize = static_cast<size_t>(status.st_size);
+    void* const kMapping = ::mmap(nullptr, kSize, PROT_READ, MAP_PRIVATE, kFile, 0);
+    ::close(kFile);
+    if (kMapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_data = static_cast<const unsigned char*>(kMapping);
+    m_size = kSize;
+    m_isMapped = true;
+    if (m_access == Access::Sequential)
+    {
+        advise(0, m_size, MADV_SEQUENTIAL);
+        consume(0);
+    }
+    return true;
+#else
+    unused(fileName);
+    return false;
+#endif
+}
+
+bool MappedFile::load(const std::string& fileName)
+{
+    // Отображение недоступно (или файл пуст): файл считывается в буфер, выровненный по строке кэша.
+    std::ifstream in(fileName, std::ios::binary | std::ios::ate);
+    if (!in.good())
+    {
+        Logger::error(fileName + ": " + strerror(errno));
+        return false;
+    }
+
+    m_size = static_cast<size_t>(in.tellg());
+    m_buffer.resize(m_size);
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_size));
+    if (!in.good())
+    {
+        Logger::error(fileName + ": failed to read the file.");
+        m_buffer.clear();
+        m_size = 0;
+        return false;
+    }
+
+    m_data = m_buffer.data();
+    return true;
+}
+
+void MappedFile::advise(const size_t first, const size_t last, const int advice) const
+{
+#ifdef FOURIER_MMAP
+    // Начало области подсказки должно быть выровнено по странице.
+    const size_t kFirst = first / pageSize() * pageSize();
+    if (last > kFirst)
+    {
+        ::madvise(const_cast<unsigned char*>(m_data) + kFirst, last - kFirst, advice);
+    }
+#else
+    unused(first);
+    unused(last);
+    unused(advice);
+#endif
+}
@@ -0,0 +1,75 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+#include "aligned.h"
+
+/**
+ * @class MappedFile
+ * @brief Файл, доступный только для чтения как непрерывный буфер: файл отображается в память (POSIX mmap),
+ *        если отображение недоступно - считывается целиком в буфер, выровненный по строке кэша.
+ *
+ *        При последовательном чтении (Access::Sequential) ядру сообщается порядок доступа, а по мере чтения
+ *        (consume) заранее запрашиваются следующие kReadAheadSize байт и освобождаются уже прочитанные страницы,
+ *        поэтому файлы больше объёма оперативной памяти просматриваются со скоростью диска.
+ *
+ * @note Содержимое действительно, пока существует экземпляр MappedFile.
+ */
+class MappedFile
+{
+public:
+    /**
+     * @brief Access - ожидаемый порядок доступа к содержимому файла.
+     */
+    enum class Access
+    {
+        Random,
+        Sequential
+    };
+
+    /**
+     * @brief kReadAheadSize - объём данных, запрашиваемых заранее при последовательном чтении.
+     */
+    static const size_t kReadAheadSize = 16 * 1024 * 1024;
+
+    /**
+     * @brief MappedFile - открывает файл fileName; при ошибке isOpen() возвращает false (ошибка записывается в лог).
+     */
+    explicit MappedFile(const std::string& fileName, const Access access = Access::Random);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return m_isOpen; }
+    bool isMapped() const { return m_isMapped; }
+
+    const unsigned char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    /**
+     * @brief consume - сообщает, что данные до смещения position прочитаны (только для Access::Sequential):
+     *        запрашивает следующие данные и освобождает прочитанные страницы отображения.
+     */
+    void consume(const size_t position);
+
+private:
+    bool map(const std::string& fileName);
+    bool load(const std::string& fileName);
+    void advise(const size_t first, const size_t last, const int advice) const;
+
+private:
+    Access m_access = Access::Random;
+    bool m_isOpen = false;
+    bool m_isMapped = false;
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    AlignedVector<unsigned char> m_buffer; //!< Содержимое файла, если отображение недоступно.
+
+    size_t m_prefetchedEnd = 0;            //!< Конец запрошенных заранее данных.
+    size_t m_releasedEnd = 0;              //!< Конец освобождённых данных.
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,71 @@
+#include "oscillator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+/**
+ * @brief kLanes - количество независимых фазоров (соседних отсчётов), поворачиваемых одновременно.
+ */
+const size_t kLanes = 4;
+
+/**
+ * @brief kAnchorInterval - количество отсчётов, после которого фазоры вычисляются заново точно
+ *        (ограничивает накопление погрешности поворота: kAnchorInterval / kLanes умножений на фазор).
+ */
+const size_t kAnchorInterval = 64;
+
+}
+
+namespace oscillator
+{
+
+void addSine(Span<double> output,
+             const size_t firstIndex,
+             const double freqFactor,
+             const double startPhase,
+             const double amplitude)
+{
+    const size_t kCount = output.size();
+    double* const kOutput = output.data();
+
+    // Поворот фазора на kLanes отсчётов.
+    const double kRotationAngle = static_cast<double>(kLanes) / freqFactor;
+    const double kRotationRe = std::cos(kRotationAngle);
+    const double kRotationIm = std::sin(kRotationAngle);
+
+    for (size_t blockStart = 0; blockStart < kCount; blockStart += kAnchorInterval)
+    {
+        const size_t kBlockEnd = std::min(blockStart + kAnchorInterval, kCount);
+
+        // Фазор потока lane: amplitude * exp(i * ((index + lane) / freqFactor + startPhase)), мнимая часть - значение синусоиды.
+        double re[kLanes];
+        double im[kLanes];
+        for (size_t lane = 0; lane < kLanes; ++lane)
+        {
+            const double kArgument = static_cast<double>(firstIndex + blockStart + lane) / freqFactor + startPhase;
+            re[lane] = amplitude * std::cos(kArgument);
+            im[lane] = amplitude * std::sin(kArgument);
+        }
+
+        size_t index = blockStart;
+        for (; index + kLanes <= kBlockEnd; index += kLanes)
+        {
+            for (size_t lane = 0; lane < kLanes; ++lane)
+            {
+                kOutput[index + lane] += im[lane];
+
+                const double kRe = re[lane] * kRotationRe - im[lane] * kRotationIm;
+                im[lane] = re[lane] * kRotationIm + im[lane] * kRotationRe;
+                re[lane] = kRe;
+            }
+        }
+        for (size_t lane = 0; index < kBlockEnd; ++index, ++lane)
+        {
+            kOutput[index] += im[lane];
+        }
+    }
+}
+
+} // oscillator
@@ -0,0 +1,38 @@
+#ifndef OSCILLATOR_H
+#define OSCILLATOR_H
+
+#include <cstddef>
+
+#include "span.h"
+
+namespace oscillator
+{
+/**
+ * @brief kMaxError - наибольшая абсолютная погрешность addSine относительно
+ *        amplitude * std::sin(index / freqFactor + startPhase), отнесённая к |amplitude|.
+ *        К ней добавляется погрешность округления аргумента (в эталонном выражении и при точном вычислении фазоров):
+ *        не более 2 * |index / freqFactor + startPhase| * DBL_EPSILON (существенна лишь для очень длинных сигналов).
+ */
+const double kMaxError = 1.0e-13;
+
+/**
+ * @brief addSine - добавляет к значениям output отсчёты синусоиды:
+ *        output[i] += amplitude * sin((firstIndex + i) / freqFactor + startPhase), i в [0, output.size()).
+ *        Вместо вызова std::sin для каждого отсчёта фаза поворачивается комплексным множителем (рекуррентный фазор)
+ *        в нескольких независимых потоках отсчётов (векторизуется компилятором). Каждые несколько десятков отсчётов
+ *        фазоры заново вычисляются точно, поэтому погрешность не накапливается (см. kMaxError).
+ * @param output - буфер, к значениям которого добавляется синусоида.
+ * @param firstIndex - индекс отсчёта синусоиды, соответствующего output[0].
+ * @param freqFactor - множитель частоты (частота определяется как i/freqFactor, см. SineOption).
+ * @param startPhase - начальная фаза.
+ * @param amplitude - амплитуда.
+ */
+void addSine(Span<double> output,
+             const size_t firstIndex,
+             const double freqFactor,
+             const double startPhase,
+             const double amplitude);
+
+} // oscillator
+
+#endif // OSCILLATOR_H
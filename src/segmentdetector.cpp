@@ -0,0 +1,119 @@
+#include "segmentdetector.h"
+
+#include <cassert>
+
+SegmentDetector::SegmentDetector(const SegmentDetectorOptions& options,
+                                 const SegmentHandler& handler) :
+    m_options(options),
+    m_handler(handler)
+{
+    assert(m_options.lowerThreshold <= m_options.upperThreshold);
+}
+
+void SegmentDetector::push(const double value)
+{
+    const size_t kPosition = m_position++;
+
+    const bool kWasAbove = m_isAbove;
+    m_isAbove = (value >= (kWasAbove ? m_options.lowerThreshold : m_options.upperThreshold));
+
+    if (m_isAbove && !kWasAbove)
+    {
+        // Начало очередного отрезка выше порога: он продолжает текущий, если промежуток объединяется.
+        if (!m_isSegmentOpen || !isGapMerged(kPosition - (m_segment.start + m_segment.length)))
+        {
+            closeSegment();
+            m_isSegmentOpen = true;
+            m_segment.start = kPosition;
+            m_segmentSum = 0.0;
+        }
+    }
+
+    if (m_isSegmentOpen)
+    {
+        m_segmentSum += value;
+        if (m_isAbove)
+        {
+            m_segment.length = kPosition + 1 - m_segment.start;
+            m_segment.sum = m_segmentSum;
+        }
+    }
+}
+
+void SegmentDetector::push(Span<const double> values)
+{
+    for (const double each : values)
+    {
+        push(each);
+    }
+}
+
+void SegmentDetector::finish()
+{
+    closeSegment();
+}
+
+bool SegmentDetector::isGapMerged(const size_t gap)
+{
+    const size_t kNumber = ++m_gapsCount;
+    if (gap > m_options.maxGap)
+    {
+        return false;
+    }
+    if (m_options.merging == GapMerging::Adjacent)
+    {
+        return true;
+    }
+
+    if (kNumber % 2 == 1)
+    {
+        // Нечётный номер: промежуток объединяется на первом проходе,
+        // номера всех последующих промежутков на следующих проходах меняют чётность.
+        m_isFirstPassOdd = !m_isFirstPassOdd;
+        return true;
+    }
+
+    // Чётный номер: промежуток объединяется на проходе, следующем за первым проходом t, после которого
+    // количество объединений предшествующих промежутков нечётно (если такого прохода нет - не объединяется никогда).
+    // Объединение меняет чётность для всех проходов после t + 1.
+    size_t pass = 1;
+    if (!m_isFirstPassOdd)
+    {
+        if (m_parityChanges.empty())
+        {
+            return false;
+        }
+        pass = m_parityChanges.front();
+        m_parityChanges.pop_front();
+    }
+
+    const size_t kChange = pass + 1;
+    if (!m_parityChanges.empty() && m_parityChanges.front() == kChange)
+    {
+        m_parityChanges.pop_front();
+    }
+    else
+    {
+        m_parityChanges.push_front(kChange);
+    }
+
+    if (!m_isFirstPassOdd)
+    {
+        m_parityChanges.push_front(pass);
+    }
+    return true;
+}
+
+void SegmentDetector::closeSegment()
+{
+    if (!m_isSegmentOpen)
+    {
+        return;
+    }
+    m_isSegmentOpen = false;
+
+    if (m_segment.length >= m_options.minimumLength)
+    {
+        m_handler(m_segment);
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef SEGMENTDETECTOR_H
+#define SEGMENTDETECTOR_H
+
+#include <deque>
+#include <functional>
+
+#include "span.h"
+
+/**
+ * @struct Segment
+ * @brief Отрезок последовательности значений, обнаруженный SegmentDetector.
+ */
+struct Segment
+{
+    size_t start = 0;  //!< Индекс первого значения отрезка.
+    size_t length = 0; //!< Количество значений отрезка.
+    double sum = 0.0;  //!< Сумма значений отрезка (включая значения объединённых промежутков).
+
+    /**
+     * @brief mean - среднее значение отрезка.
+     */
+    double mean() const { return (length > 0 ? sum / static_cast<double>(length) : 0.0); }
+};
+
+/**
+ * @brief GapMerging - правило объединения отрезков, разделённых коротким промежутком.
+ */
+enum class GapMerging
+{
+    Adjacent, //!< Объединяются любые соседние отрезки, промежуток между которыми не длиннее наибольшего.
+    Pairwise  //!< Результат повторяемого до неподвижной точки попарного объединения: отрезки (0, 1), (2, 3), ...
+              //!< объединяются, если промежуток между ними не длиннее наибольшего, после чего нумерация
+              //!< повторяется для полученной последовательности (правило, по которому decompose выделяет отрезки).
+};
+
+/**
+ * @struct SegmentDetectorOptions
+ * @brief Параметры выделения отрезков.
+ */
+struct SegmentDetectorOptions
+{
+    double upperThreshold = 0.0;               //!< Отрезок начинается со значения не ниже верхнего порога.
+    double lowerThreshold = 0.0;               //!< Отрезок продолжается, пока значения не ниже нижнего порога (не выше верхнего).
+    size_t maxGap = 0;                         //!< Наибольший объединяемый промежуток.
+    size_t minimumLength = 0;                  //!< Наименьшая длина отрезка (после объединения).
+    GapMerging merging = GapMerging::Adjacent; //!< Правило объединения.
+};
+
+/**
+ * @class SegmentDetector
+ * @brief Выделение отрезков последовательности значений за один проход: пороговое выделение с гистерезисом,
+ *        объединение отрезков, разделённых промежутками не длиннее maxGap, и отбрасывание отрезков короче minimumLength.
+ *        Сумма значений отрезка накапливается по ходу прохода. O(1) в среднем на значение, объём памяти не зависит
+ *        от длины последовательности; отрезок передаётся обработчику, как только становится известно, что он завершён.
+ *
+ * @note При совпадающих порогах и правиле GapMerging::Pairwise результат совпадает с последовательным выделением
+ *       отрезков выше порога и их попарным объединением до неподвижной точки.
+ */
+class SegmentDetector
+{
+public:
+    using SegmentHandler = std::function<void(const Segment&)>;
+
+    SegmentDetector(const SegmentDetectorOptions& options,
+                    const SegmentHandler& handler);
+
+    /**
+     * @brief push - обрабатывает очередное значение последовательности.
+     */
+    void push(const double value);
+
+    /**
+     * @brief push - обрабатывает очередной блок значений последовательности.
+     */
+    void push(Span<const double> values);
+
+    /**
+     * @brief finish - завершает последовательность и передаёт обработчику незавершённый отрезок.
+     */
+    void finish();
+
+private:
+    bool isGapMerged(const size_t gap);
+    void closeSegment();
+
+private:
+    SegmentDetectorOptions m_options;
+    SegmentHandler m_handler;
+
+    size_t m_position = 0;         //!< Индекс очередного значения.
+    bool m_isAbove = false;        //!< Находится ли текущее значение внутри отрезка выше порога.
+    bool m_isSegmentOpen = false;
+    Segment m_segment;             //!< Текущий отрезок: [start, start + length) и сумма его значений.
+    double m_segmentSum = 0.0;     //!< Сумма значений от начала текущего отрезка (включая текущий промежуток).
+
+    // Состояние правила GapMerging::Pairwise. Промежуток с номером j (от 1) объединяется на первом проходе,
+    // на котором его номер в текущей последовательности нечётен; номер уменьшается на количество промежутков
+    // перед ним, объединённых на предыдущих проходах. Для уже просмотренных промежутков хранится чётность
+    // количества объединений, выполненных на проходах 1..t, как функция t: значение при t = 1 и точки её смены.
+    size_t m_gapsCount = 0;
+    bool m_isFirstPassOdd = false;
+    std::deque<size_t> m_parityChanges;
+};
+
+#endif // SEGMENTDETECTOR_H
@@ -0,0 +1,574 @@
+#include "signalreader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "logger.h"
+
+namespace
+{
+/**
+ * @brief kReadLength - длина фрагмента, которыми readAll читает сигнал неизвестной длины.
+ */
+const size_t kReadLength = 64 * 1024;
+
+/**
+ * @brief kPowersOf10 - точно представимые в double степени 10.
+ */
+const double kPowersOf10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const int kMaxExactPower = 22;
+
+/**
+ * @brief kMaxExactMantissa - наибольшее целое, все меньшие которого точно представимы в double.
+ */
+const uint64_t kMaxExactMantissa = 1ULL << 53;
+
+/**
+ * @brief kMaxMantissaDigits - количество значащих цифр, накапливаемых в 64-битной мантиссе без переполнения.
+ */
+const int kMaxMantissaDigits = 19;
+
+/**
+ * @brief kMaxExponent - предел абсолютного значения порядка при разборе (больше - заведомо переполнение или нуль).
+ */
+const int kMaxExponent = 100000;
+
+/**
+ * @brief kMaxShortNumberLength - длина текста числа, копируемого для strtod в буфер на стеке.
+ */
+const size_t kMaxShortNumberLength = 127;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+const bool kIsLittleEndian = true;
+#else
+const bool kIsLittleEndian = false;
+#endif
+
+bool isDigit(const char symbol)
+{
+    return (symbol >= '0' && symbol <= '9');
+}
+
+bool isBlank(const char symbol)
+{
+    return (symbol == ' ' || symbol == '\t' || symbol == '\r');
+}
+
+/**
+ * @struct DecimalNumber
+ * @brief Десятичное число mantissa * 10^exponent, накапливаемое по цифрам.
+ */
+struct DecimalNumber
+{
+    uint64_t mantissa = 0;
+    int digitsCount = 0;       //!< Количество значащих цифр в mantissa.
+    int exponent = 0;
+    bool isTruncated = false;  //!< Отброшены ли ненулевые цифры сверх kMaxMantissaDigits.
+
+    void append(const int digit, const bool isFraction)
+    {
+        if (digitsCount < kMaxMantissaDigits)
+        {
+            if (mantissa != 0 || digit != 0)
+            {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(digit);
+                ++digitsCount;
+            }
+            if (isFraction)
+            {
+                --exponent;
+            }
+        }
+        else
+        {
+            if (!isFraction)
+            {
+                ++exponent;
+            }
+            isTruncated = (isTruncated || digit != 0);
+        }
+    }
+};
+
+/**
+ * @brief parseWithStrtod - разбирает число в начале текста [first, last) функцией strtod
+ *        (текст копируется, так как strtod требует завершающего нуля).
+ */
+const char* parseWithStrtod(const char* first, const char* last, double& value)
+{
+    const size_t kLength = static_cast<size_t>(last - first);
+
+    char shortText[kMaxShortNumberLength + 1];
+    std::string longText;
+    char* text = shortText;
+    if (kLength <= kMaxShortNumberLength)
+    {
+        std::memcpy(shortText, first, kLength);
+        shortText[kLength] = '\0';
+    }
+    else
+    {
+        longText.assign(first, last);
+        text = &longText[0];
+    }
+
+    char* end = nullptr;
+    const double kValue = std::strtod(text, &end);
+    if (end == text)
+    {
+        return first;
+    }
+
+    value = kValue;
+    return first + (end - text);
+}
+
+/**
+ * @brief findField - границы поля column (без окружающих пробелов) строки [first, last) с разделителем separator.
+ * @return false, если в строке меньше столбцов.
+ */
+bool findField(const char* first,
+               const char* last,
+               const size_t column,
+               const char separator,
+               const char*& fieldFirst,
+               const char*& fieldLast)
+{
+    for (size_t i = 0; i < column; ++i)
+    {
+        first = static_cast<const char*>(std::memchr(first, separator, static_cast<size_t>(last - first)));
+        if (first == nullptr)
+        {
+            return false;
+        }
+        ++first;
+    }
+
+    const char* const kSeparator = static_cast<const char*>(std::memchr(first, separator, static_cast<size_t>(last - first)));
+    fieldFirst = first;
+    fieldLast = (kSeparator != nullptr ? kSeparator : last);
+
+    while (fieldFirst != fieldLast && ::isBlank(*fieldFirst))
+    {
+        ++fieldFirst;
+    }
+    while (fieldLast != fieldFirst && ::isBlank(*(fieldLast - 1)))
+    {
+        --fieldLast;
+    }
+    return true;
+}
+
+/**
+ * @brief lineEnd - конец строки, начинающейся с first (символ '\n' или last).
+ */
+const char* lineEnd(const char* first, const char* last)
+{
+    const char* const kEnd = static_cast<const char*>(std::memchr(first, '\n', static_cast<size_t>(last - first)));
+    return (kEnd != nullptr ? kEnd : last);
+}
+
+/**
+ * @brief loadSample - значение типа T, хранимое в порядке байтов little-endian по адресу source (без требований к выравниванию).
+ */
+template <typename T>
+T loadSample(const unsigned char* source)
+{
+    unsigned char bytes[sizeof(T)];
+    if (kIsLittleEndian)
+    {
+        std::memcpy(bytes, source, sizeof(T));
+    }
+    else
+    {
+        std::reverse_copy(source, source + sizeof(T), bytes);
+    }
+
+    T result;
+    std::memcpy(&result, bytes, sizeof(T));
+    return result;
+}
+
+/**
+ * @brief decodeSamples - преобразует count отсчётов типа T, расположенных с шагом stride байт, в значения double.
+ */
+template <typename T>
+void decodeSamples(const unsigned char* source,
+                   const size_t stride,
+                   const size_t count,
+                   const double scale,
+                   double* destination)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        destination[i] = scale * static_cast<double>(::loadSample<T>(source + i * stride));
+    }
+}
+
+}
+
+const char* parseDouble(const char* first, const char* last, double& value)
+{
+    const char* position = first;
+    bool isNegative = false;
+    if (position != last && (*position == '-' || *position == '+'))
+    {
+        isNegative = (*position == '-');
+        ++position;
+    }
+
+    DecimalNumber number;
+    bool hasDigits = false;
+    for (; position != last && ::isDigit(*position); ++position)
+    {
+        number.append(*position - '0', false);
+        hasDigits = true;
+    }
+    if (position != last && *position == '.')
+    {
+        for (++position; position != last && ::isDigit(*position); ++position)
+        {
+            number.append(*position - '0', true);
+            hasDigits = true;
+        }
+    }
+
+    if (!hasDigits)
+    {
+        // Не десятичное число: "nan", "inf" и т.п.
+        return ::parseWithStrtod(first, std::min(last, first + kMaxShortNumberLength), value);
+    }
+
+    if (position != last && (*position == 'e' || *position == 'E'))
+    {
+        const char* exponentPosition = position + 1;
+        bool isExponentNegative = false;
+        if (exponentPosition != last && (*exponentPosition == '-' || *exponentPosition == '+'))
+        {
+            isExponentNegative = (*exponentPosition == '-');
+            ++exponentPosition;
+        }
+
+        if (exponentPosition != last && ::isDigit(*exponentPosition))
+        {
+            int exponent = 0;
+            for (; exponentPosition != last && ::isDigit(*exponentPosition); ++exponentPosition)
+            {
+                exponent = std::min(exponent * 10 + (*exponentPosition - '0'), kMaxExponent);
+            }
+            number.exponent += (isExponentNegative ? -exponent : exponent);
+            position = exponentPosition;
+        }
+    }
+
+    if (number.mantissa == 0 && !number.isTruncated)
+    {
+        value = (isNegative ? -0.0 : 0.0);
+        return position;
+    }
+
+    // Точный результат: мантисса и степень 10 представимы в double, деление или умножение округляется один раз.
+    if (!number.isTruncated
+        && number.mantissa <= kMaxExactMantissa
+        && number.exponent >= -kMaxExactPower
+        && number.exponent <= kMaxExactPower)
+    {
+        double result = static_cast<double>(number.mantissa);
+        if (number.exponent < 0)
+        {
+            result /= kPowersOf10[-number.exponent];
+        }
+        else
+        {
+            result *= kPowersOf10[number.exponent];
+        }
+        value = (isNegative ? -result : result);
+        return position;
+    }
+
+    return ::parseWithStrtod(first, position, value);
+}
+
+SignalFormat signalFormatFromFileName(const std::string& fileName)
+{
+    const size_t kDot = fileName.rfind('.');
+    const std::string kExtension = (kDot != std::string::npos ? fileName.substr(kDot) : std::string());
+    if (kExtension == ".f32")
+    {
+        return SignalFormat::Float32;
+    }
+    if (kExtension == ".f64")
+    {
+        return SignalFormat::Float64;
+    }
+    if (kExtension == ".s16")
+    {
+        return SignalFormat::Int16;
+    }
+    return SignalFormat::Csv;
+}
+
+SignalReader::SignalReader(const std::string& fileName, const SignalReaderOptions& options) :
+    m_fileName(fileName),
+    m_options(options),
+    m_format(options.format != SignalFormat::Auto ? options.format : signalFormatFromFileName(fileName)),
+    m_file(fileName, MappedFile::Access::Sequential)
+{
+    if (!m_file.isOpen())
+    {
+        return;
+    }
+
+    if (m_format == SignalFormat::Csv)
+    {
+        m_isOpen = openCsv(fileName);
+        return;
+    }
+
+    if (m_options.channelsCount == 0 || m_options.channel >= m_options.channelsCount)
+    {
+        Logger::error(fileName + ": channel " + std::to_string(m_options.channel)
+                      + " is out of " + std::to_string(m_options.channelsCount) + " channels.");
+        return;
+    }
+    if (m_options.headerSize > m_file.size())
+    {
+        Logger::error(fileName + ": the header is longer than the file.");
+        return;
+    }
+
+    m_position = m_options.headerSize;
+    m_isOpen = true;
+}
+
+size_t SignalReader::samplesCount() const
+{
+    if (!m_isOpen || m_format == SignalFormat::Csv)
+    {
+        return 0;
+    }
+    return (m_file.size() - m_options.headerSize) / (m_options.channelsCount * sampleSize());
+}
+
+Span<const double> SignalReader::view() const
+{
+    const bool kIsViewable = (m_isOpen
+                              && kIsLittleEndian
+                              && m_format == SignalFormat::Float64
+                              && m_options.channelsCount == 1
+                              && m_options.headerSize % sizeof(double) == 0
+                              && m_options.scale == 1.0);
+    if (!kIsViewable)
+    {
+        return Span<const double>();
+    }
+    return Span<const double>(reinterpret_cast<const double*>(m_file.data() + m_options.headerSize), samplesCount());
+}
+
+size_t SignalReader::read(Span<double> buffer)
+{
+    if (!good())
+    {
+        return 0;
+    }
+
+    const size_t kCount = (m_format == SignalFormat::Csv ? readCsv(buffer) : readRaw(buffer));
+    m_readCount += kCount;
+    m_file.consume(m_position);
+    return kCount;
+}
+
+size_t SignalReader::readChunks(const size_t chunkLength, const ChunkHandler& handler)
+{
+    const size_t kChunkLength = std::max<size_t>(chunkLength, 1);
+    size_t result = 0;
+
+    // Значения, хранимые как double, передаются непосредственно из отображения.
+    const Span<const double> kView = view();
+    if (!kView.empty())
+    {
+        while (m_readCount < kView.size())
+        {
+            const Span<const double> kChunk = kView.subspan(m_readCount, kChunkLength);
+            handler(kChunk);
+            m_readCount += kChunk.size();
+            m_position += kChunk.size() * sizeof(double);
+            m_file.consume(m_position);
+            result += kChunk.size();
+        }
+        return result;
+    }
+
+    std::vector<double> chunk(kChunkLength);
+    while (true)
+    {
+        const size_t kCount = read(chunk);
+        if (kCount == 0)
+        {
+            break;
+        }
+
+        handler(Span<const double>(chunk.data(), kCount));
+        result += kCount;
+    }
+    return result;
+}
+
+std::vector<double> SignalReader::readAll()
+{
+    std::vector<double> result;
+    if (m_format != SignalFormat::Csv)
+    {
+        result.resize(samplesCount() - std::min(samplesCount(), m_readCount));
+        result.resize(read(result));
+        return result;
+    }
+
+    readChunks(kReadLength, [&result](Span<const double> chunk)
+    {
+        result.insert(std::end(result), std::begin(chunk), std::end(chunk));
+    });
+    return result;
+}
+
+bool SignalReader::openCsv(const std::string& fileName)
+{
+    const char* const kFirst = reinterpret_cast<const char*>(m_file.data());
+    const char* const kLast = kFirst + m_file.size();
+    if (kFirst == kLast)
+    {
+        return true;
+    }
+
+    const char* const kLineEnd = ::lineEnd(kFirst, kLast);
+    const size_t kNextLine = static_cast<size_t>(kLineEnd - kFirst) + (kLineEnd != kLast ? 1 : 0);
+
+    if (!m_options.columnName.empty())
+    {
+        // Столбец определяется по строке заголовков.
+        for (size_t column = 0; ; ++column)
+        {
+            const char* fieldFirst = nullptr;
+            const char* fieldLast = nullptr;
+            if (!::findField(kFirst, kLineEnd, column, m_options.separator, fieldFirst, fieldLast))
+            {
+                Logger::error(fileName + ": no column '" + m_options.columnName + "'.");
+                return false;
+            }
+            if (std::string(fieldFirst, fieldLast) == m_options.columnName)
+            {
+                m_options.column = column;
+                break;
+            }
+        }
+
+        m_position = kNextLine;
+        m_line = 1;
+        return true;
+    }
+
+    // Первая строка - строка заголовков, если в читаемом столбце нет числа.
+    const char* fieldFirst = nullptr;
+    const char* fieldLast = nullptr;
+    double value = 0.0;
+    if (::findField(kFirst, kLineEnd, m_options.column, m_options.separator, fieldFirst, fieldLast)
+        && fieldFirst != fieldLast
+        && parseDouble(fieldFirst, fieldLast, value) != fieldLast)
+    {
+        m_position = kNextLine;
+        m_line = 1;
+    }
+    return true;
+}
+
+size_t SignalReader::readRaw(Span<double> buffer)
+{
+    const size_t kSampleSize = sampleSize();
+    const size_t kFrameSize = m_options.channelsCount * kSampleSize;
+    const size_t kCount = std::min(buffer.size(), (m_file.size() - m_position) / kFrameSize);
+    const unsigned char* const kSource = m_file.data() + m_position + m_options.channel * kSampleSize;
+
+    switch (m_format)
+    {
+    case SignalFormat::Float32:
+        ::decodeSamples<float>(kSource, kFrameSize, kCount, m_options.scale, buffer.data());
+        break;
+    case SignalFormat::Float64:
+        ::decodeSamples<double>(kSource, kFrameSize, kCount, m_options.scale, buffer.data());
+        break;
+    case SignalFormat::Int16:
+        ::decodeSamples<int16_t>(kSource, kFrameSize, kCount, m_options.scale, buffer.data());
+        break;
+    default:
+        break;
+    }
+
+    m_position += kCount * kFrameSize;
+    return kCount;
+}
+
+size_t SignalReader::readCsv(Span<double> buffer)
+{
+    const char* const kFirst = reinterpret_cast<const char*>(m_file.data());
+    const char* const kLast = kFirst + m_file.size();
+
+    const char* position = kFirst + m_position;
+    size_t count = 0;
+    while (count < buffer.size() && position != kLast)
+    {
+        const char* const kLineEnd = ::lineEnd(position, kLast);
+        const char* fieldFirst = nullptr;
+        const char* fieldLast = nullptr;
+        if (::findField(position, kLineEnd, m_options.column, m_options.separator, fieldFirst, fieldLast)
+            && fieldFirst != fieldLast)
+        {
+            double value = 0.0;
+            if (parseDouble(fieldFirst, fieldLast, value) != fieldLast)
+            {
+                Logger::error(m_fileName + ": line " + std::to_string(m_line + 1) + ": invalid value '"
+                              + std::string(fieldFirst, fieldLast) + "'.");
+                m_isFailed = true;
+                break;
+            }
+            buffer[count++] = value;
+        }
+
+        position = (kLineEnd != kLast ? kLineEnd + 1 : kLast);
+        ++m_line;
+    }
+
+    m_position = static_cast<size_t>(position - kFirst);
+    return count;
+}
+
+size_t SignalReader::sampleSize() const
+{
+    switch (m_format)
+    {
+    case SignalFormat::Float32:
+        return sizeof(float);
+    case SignalFormat::Int16:
+        return sizeof(int16_t);
+    default:
+        return sizeof(double);
+    }
+}
+
+Span<const double> loadSignal(SignalReader& reader, std::vector<double>& storage)
+{
+    const Span<const double> kView = reader.view();
+    if (!kView.empty())
+    {
+        return kView;
+    }
+
+    storage = reader.readAll();
+    return storage;
+}
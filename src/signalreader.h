@@ -0,0 +1,155 @@
+#ifndef SIGNALREADER_H
+#define SIGNALREADER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "mappedfile.h"
+#include "span.h"
+
+/**
+ * @brief parseDouble - разбирает десятичное число в начале текста [first, last) без выделения памяти
+ *        и без учёта локали. Числа до 19 значащих цифр с порядком до ±22, точно представимые в double,
+ *        разбираются целочисленно (точный результат); остальные, а также "nan" и "inf", - функцией strtod.
+ * @param first, last - границы текста.
+ * @param value - разобранное значение.
+ * @return указатель на первый символ после числа; first, если число не найдено.
+ */
+const char* parseDouble(const char* first, const char* last, double& value);
+
+/**
+ * @brief SignalFormat - формат файла записанного сигнала.
+ */
+enum class SignalFormat
+{
+    Auto,    //!< По расширению имени файла (см. signalFormatFromFileName).
+    Csv,     //!< Текстовый csv-файл: значения сигнала в одном из столбцов.
+    Float32, //!< Двоичные значения float (little-endian), расширение ".f32".
+    Float64, //!< Двоичные значения double (little-endian), расширение ".f64".
+    Int16    //!< Двоичные 16-битные целые отсчёты (little-endian), расширение ".s16".
+};
+
+/**
+ * @brief signalFormatFromFileName - формат файла сигнала по расширению имени fileName (Csv для неизвестных расширений).
+ */
+SignalFormat signalFormatFromFileName(const std::string& fileName);
+
+/**
+ * @struct SignalReaderOptions
+ * @brief Параметры чтения файла записанного сигнала.
+ */
+struct SignalReaderOptions
+{
+    SignalFormat format = SignalFormat::Auto;
+
+    // Двоичные форматы:
+    size_t headerSize = 0;     //!< Длина заголовка перед отсчётами (в байтах).
+    size_t channelsCount = 1;  //!< Количество каналов (отсчёты каналов чередуются).
+    size_t channel = 0;        //!< Читаемый канал.
+    double scale = 1.0;        //!< Множитель значений (например, 1.0 / 32768 для нормировки Int16).
+
+    // Формат csv:
+    size_t column = 0;         //!< Индекс столбца значений сигнала.
+    std::string columnName;    //!< Имя столбца в строке заголовков (если задано, заменяет column).
+    char separator = ',';      //!< Разделитель столбцов.
+};
+
+/**
+ * @class SignalReader
+ * @brief Чтение записанного сигнала из файла, отображённого в память (см. MappedFile), фрагментами произвольной длины:
+ *        значения преобразуются в double непосредственно из отображения, без промежуточных буферов.
+ *        Файл читается последовательно с подсказками ядру об опережающем чтении, поэтому фрагментами (readChunks)
+ *        можно обработать файл больше объёма оперативной памяти, передавая их, например, в StreamingDecomposer.
+ *
+ *        Для csv-файла первая строка считается строкой заголовков, если в читаемом столбце нет числа;
+ *        строки с пустым значением в читаемом столбце (короткий столбец) пропускаются.
+ *
+ * @note Экземпляр не предназначен для одновременного использования из нескольких потоков.
+ */
+class SignalReader
+{
+public:
+    using ChunkHandler = std::function<void(Span<const double>)>;
+
+    /**
+     * @brief SignalReader - открывает файл fileName; при ошибке isOpen() возвращает false (ошибка записывается в лог).
+     */
+    explicit SignalReader(const std::string& fileName,
+                          const SignalReaderOptions& options = SignalReaderOptions());
+
+    SignalReader(const SignalReader&) = delete;
+    SignalReader& operator=(const SignalReader&) = delete;
+
+    bool isOpen() const { return m_isOpen; }
+
+    /**
+     * @brief good - открыт ли файл и не встретились ли ошибки разбора значений.
+     */
+    bool good() const { return (m_isOpen && !m_isFailed); }
+
+    SignalFormat format() const { return m_format; }
+
+    /**
+     * @brief samplesCount - количество отсчётов сигнала в двоичном файле (для csv - 0: количество неизвестно до чтения).
+     */
+    size_t samplesCount() const;
+
+    /**
+     * @brief readCount - количество прочитанных отсчётов.
+     */
+    size_t readCount() const { return m_readCount; }
+
+    /**
+     * @brief view - все отсчёты сигнала без копирования, если значения в файле хранятся как double
+     *        (формат Float64, один канал, выровненный заголовок, множитель 1.0, порядок байтов little-endian);
+     *        иначе пустое представление.
+     */
+    Span<const double> view() const;
+
+    /**
+     * @brief read - читает очередные отсчёты сигнала в буфер buffer.
+     * @return количество прочитанных отсчётов (меньше buffer.size() только в конце файла или при ошибке).
+     */
+    size_t read(Span<double> buffer);
+
+    /**
+     * @brief readChunks - читает оставшиеся отсчёты фрагментами длиной chunkLength (последний может быть короче)
+     *        и передаёт их обработчику handler.
+     * @return количество прочитанных отсчётов.
+     */
+    size_t readChunks(const size_t chunkLength, const ChunkHandler& handler);
+
+    /**
+     * @brief readAll - читает все оставшиеся отсчёты сигнала.
+     */
+    std::vector<double> readAll();
+
+private:
+    bool openCsv(const std::string& fileName);
+    size_t readRaw(Span<double> buffer);
+    size_t readCsv(Span<double> buffer);
+
+    size_t sampleSize() const;
+
+private:
+    std::string m_fileName;
+    SignalReaderOptions m_options;
+    SignalFormat m_format = SignalFormat::Csv;
+    MappedFile m_file;
+    bool m_isOpen = false;
+    bool m_isFailed = false;
+
+    size_t m_position = 0;       //!< Смещение следующих непрочитанных данных в файле.
+    size_t m_readCount = 0;
+    size_t m_line = 0;           //!< Количество прочитанных строк csv-файла (для сообщений об ошибках).
+};
+
+/**
+ * @brief loadSignal - все отсчёты сигнала из ещё не читавшегося reader для пакетной обработки (например, decompose):
+ *        представление без копирования (SignalReader::view), если оно доступно, иначе значения, прочитанные в storage.
+ * @note Результат действителен, пока существуют reader и storage.
+ */
+Span<const double> loadSignal(SignalReader& reader, std::vector<double>& storage);
+
+#endif // SIGNALREADER_H
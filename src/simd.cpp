@@ -0,0 +1,580 @@
+#include "simd.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define FOURIER_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+/**
+ * Коэффициенты приближения atan(a) ~ a * P(a^2) на отрезке [0, 1] (метод наименьших квадратов по узлам Чебышёва,
+ * наибольшая погрешность ~2.1e-9 рад).
+ */
+const double kAtanCoefficients[] =
+{
+     0.9999999990537064,
+    -0.33333296715154853,
+     0.19998542266986255,
+    -0.14264389793840779,
+     0.10953449852564509,
+    -0.08407879226722853,
+     0.058040452001099543,
+    -0.031264506559922793,
+     0.010962443144767541,
+    -0.0018044901810090619
+};
+const size_t kAtanCoefficientsCount = sizeof(kAtanCoefficients) / sizeof(kAtanCoefficients[0]);
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Скалярные реализации (используются также для "хвостов" векторизованных реализаций).
+
+void scalarMultiply(const std::complex<double>* lhs,
+                    const std::complex<double>* rhs,
+                    std::complex<double>* result,
+                    const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const double kRe = lhs[i].real() * rhs[i].real() - lhs[i].imag() * rhs[i].imag();
+        const double kIm = lhs[i].imag() * rhs[i].real() + lhs[i].real() * rhs[i].imag();
+        result[i] = { kRe, kIm };
+    }
+}
+
+void scalarSquaredMagnitude(const std::complex<double>* values, double* result, const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        result[i] = values[i].real() * values[i].real() + values[i].imag() * values[i].imag();
+    }
+}
+
+void scalarMagnitude(const std::complex<double>* values, double* result, const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        result[i] = std::sqrt(values[i].real() * values[i].real() + values[i].imag() * values[i].imag());
+    }
+}
+
+double scalarAtan2(const double y, const double x)
+{
+    const double kAbsX = std::fabs(x);
+    const double kAbsY = std::fabs(y);
+    const double kMax = (kAbsY > kAbsX ? kAbsY : kAbsX);
+    const double kMin = (kAbsY > kAbsX ? kAbsX : kAbsY);
+    const double kRatio = (kMax == 0.0 ? 0.0 : kMin / kMax);
+    const double kSquare = kRatio * kRatio;
+
+    double polynom = kAtanCoefficients[kAtanCoefficientsCount - 1];
+    for (size_t i = kAtanCoefficientsCount - 1; i > 0; --i)
+    {
+        polynom = polynom * kSquare + kAtanCoefficients[i - 1];
+    }
+
+    double result = kRatio * polynom;
+    if (kAbsY > kAbsX)
+    {
+        result = M_PI_2 - result;
+    }
+    if (std::signbit(x))
+    {
+        result = M_PI - result;
+    }
+    return std::copysign(result, y);
+}
+
+void scalarPhase(const std::complex<double>* values, double* result, const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        result[i] = scalarAtan2(values[i].imag(), values[i].real());
+    }
+}
+
+#ifdef FOURIER_SIMD_X86
+
+// ---------------------------------------------------------------------------------------------------------------------
+// SSE2 (базовый набор инструкций x86-64): два значения double в регистре.
+
+void sse2Multiply(const std::complex<double>* lhs,
+                  const std::complex<double>* rhs,
+                  std::complex<double>* result,
+                  const size_t count)
+{
+    const double* const kLhs = reinterpret_cast<const double*>(lhs);
+    const double* const kRhs = reinterpret_cast<const double*>(rhs);
+    double* const kResult = reinterpret_cast<double*>(result);
+    const __m128d kNegateLow = _mm_set_pd(0.0, -0.0);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const __m128d a = _mm_loadu_pd(kLhs + 2 * i);
+        const __m128d b = _mm_loadu_pd(kRhs + 2 * i);
+        const __m128d bRe = _mm_unpacklo_pd(b, b);
+        const __m128d bIm = _mm_unpackhi_pd(b, b);
+        const __m128d aSwapped = _mm_shuffle_pd(a, a, 1);
+        const __m128d cross = _mm_xor_pd(_mm_mul_pd(aSwapped, bIm), kNegateLow);
+        _mm_storeu_pd(kResult + 2 * i, _mm_add_pd(_mm_mul_pd(a, bRe), cross));
+    }
+}
+
+void sse2SquaredMagnitudePairs(const double* values, __m128d& squared)
+{
+    const __m128d v0 = _mm_loadu_pd(values);
+    const __m128d v1 = _mm_loadu_pd(values + 2);
+    const __m128d s0 = _mm_mul_pd(v0, v0);
+    const __m128d s1 = _mm_mul_pd(v1, v1);
+    squared = _mm_add_pd(_mm_unpacklo_pd(s0, s1), _mm_unpackhi_pd(s0, s1));
+}
+
+void sse2SquaredMagnitude(const std::complex<double>* values, double* result, const size_t count)
+{
+    const double* const kValues = reinterpret_cast<const double*>(values);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d squared;
+        sse2SquaredMagnitudePairs(kValues + 2 * i, squared);
+        _mm_storeu_pd(result + i, squared);
+    }
+    scalarSquaredMagnitude(values + i, result + i, count - i);
+}
+
+void sse2Magnitude(const std::complex<double>* values, double* result, const size_t count)
+{
+    const double* const kValues = reinterpret_cast<const double*>(values);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        __m128d squared;
+        sse2SquaredMagnitudePairs(kValues + 2 * i, squared);
+        _mm_storeu_pd(result + i, _mm_sqrt_pd(squared));
+    }
+    scalarMagnitude(values + i, result + i, count - i);
+}
+
+inline __m128d sse2Select(const __m128d mask, const __m128d ifTrue, const __m128d ifFalse)
+{
+    return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+}
+
+void sse2Phase(const std::complex<double>* values, double* result, const size_t count)
+{
+    const double* const kValues = reinterpret_cast<const double*>(values);
+    const __m128d kSignMask = _mm_set1_pd(-0.0);
+    const __m128d kZero = _mm_setzero_pd();
+    const __m128d kHalfPi = _mm_set1_pd(M_PI_2);
+    const __m128d kPi = _mm_set1_pd(M_PI);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d v0 = _mm_loadu_pd(kValues + 2 * i);
+        const __m128d v1 = _mm_loadu_pd(kValues + 2 * i + 2);
+        const __m128d x = _mm_unpacklo_pd(v0, v1);
+        const __m128d y = _mm_unpackhi_pd(v0, v1);
+
+        const __m128d absX = _mm_andnot_pd(kSignMask, x);
+        const __m128d absY = _mm_andnot_pd(kSignMask, y);
+        const __m128d isSwapped = _mm_cmpgt_pd(absY, absX);
+        const __m128d maxValue = sse2Select(isSwapped, absY, absX);
+        const __m128d minValue = sse2Select(isSwapped, absX, absY);
+        const __m128d ratio = _mm_andnot_pd(_mm_cmpeq_pd(maxValue, kZero), _mm_div_pd(minValue, maxValue));
+        const __m128d square = _mm_mul_pd(ratio, ratio);
+
+        __m128d polynom = _mm_set1_pd(kAtanCoefficients[kAtanCoefficientsCount - 1]);
+        for (size_t k = kAtanCoefficientsCount - 1; k > 0; --k)
+        {
+            polynom = _mm_add_pd(_mm_mul_pd(polynom, square), _mm_set1_pd(kAtanCoefficients[k - 1]));
+        }
+
+        __m128d angle = _mm_mul_pd(ratio, polynom);
+        angle = sse2Select(isSwapped, _mm_sub_pd(kHalfPi, angle), angle);
+
+        // Маска знакового бита x (с учётом -0.0): старшие 32 бита каждого значения размножаются арифметическим сдвигом.
+        const __m128i signBits = _mm_srai_epi32(_mm_castpd_si128(x), 31);
+        const __m128d isNegativeX = _mm_castsi128_pd(_mm_shuffle_epi32(signBits, _MM_SHUFFLE(3, 3, 1, 1)));
+        angle = sse2Select(isNegativeX, _mm_sub_pd(kPi, angle), angle);
+
+        _mm_storeu_pd(result + i, _mm_or_pd(angle, _mm_and_pd(kSignMask, y)));
+    }
+    scalarPhase(values + i, result + i, count - i);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// AVX2: четыре значения double в регистре.
+
+__attribute__((target("avx2")))
+void avx2Multiply(const std::complex<double>* lhs,
+                  const std::complex<double>* rhs,
+                  std::complex<double>* result,
+                  const size_t count)
+{
+    const double* const kLhs = reinterpret_cast<const double*>(lhs);
+    const double* const kRhs = reinterpret_cast<const double*>(rhs);
+    double* const kResult = reinterpret_cast<double*>(result);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m256d a = _mm256_loadu_pd(kLhs + 2 * i);
+        const __m256d b = _mm256_loadu_pd(kRhs + 2 * i);
+        const __m256d bRe = _mm256_movedup_pd(b);
+        const __m256d bIm = _mm256_permute_pd(b, 0xF);
+        const __m256d aSwapped = _mm256_permute_pd(a, 0x5);
+        _mm256_storeu_pd(kResult + 2 * i, _mm256_addsub_pd(_mm256_mul_pd(a, bRe), _mm256_mul_pd(aSwapped, bIm)));
+    }
+    scalarMultiply(lhs + i, rhs + i, result + i, count - i);
+}
+
+__attribute__((target("avx2")))
+inline __m256d avx2SquaredMagnitudeQuad(const double* values)
+{
+    const __m256d v0 = _mm256_loadu_pd(values);
+    const __m256d v1 = _mm256_loadu_pd(values + 4);
+    // hadd даёт порядок [0, 2, 1, 3], который восстанавливается перестановкой 64-битных элементов.
+    const __m256d sums = _mm256_hadd_pd(_mm256_mul_pd(v0, v0), _mm256_mul_pd(v1, v1));
+    return _mm256_permute4x64_pd(sums, 0xD8);
+}
+
+__attribute__((target("avx2")))
+void avx2SquaredMagnitude(const std::complex<double>* values, double* result, const size_t count)
+{
+    const double* const kValues = reinterpret_cast<const double*>(values);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(result + i, avx2SquaredMagnitudeQuad(kValues + 2 * i));
+    }
+    scalarSquaredMagnitude(values + i, result + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void avx2Magnitude(const std::complex<double>* values, double* result, const size_t count)
+{
+    const double* const kValues = reinterpret_cast<const double*>(values);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm256_storeu_pd(result + i, _mm256_sqrt_pd(avx2SquaredMagnitudeQuad(kValues + 2 * i)));
+    }
+    scalarMagnitude(values + i, result + i, count - i);
+}
+
+__attribute__((target("avx2")))
+void avx2Phase(const std::complex<double>* values, double* result, const size_t count)
+{
+    const double* const kValues = reinterpret_cast<const double*>(values);
+    const __m256d kSignMask = _mm256_set1_pd(-0.0);
+    const __m256d kZero = _mm256_setzero_pd();
+    const __m256d kHalfPi = _mm256_set1_pd(M_PI_2);
+    const __m256d kPi = _mm256_set1_pd(M_PI);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256d v0 = _mm256_loadu_pd(kValues + 2 * i);
+        const __m256d v1 = _mm256_loadu_pd(kValues + 2 * i + 4);
+        // Порядок значений после разделения: [0, 2, 1, 3].
+        const __m256d x = _mm256_unpacklo_pd(v0, v1);
+        const __m256d y = _mm256_unpackhi_pd(v0, v1);
+
+        const __m256d absX = _mm256_andnot_pd(kSignMask, x);
+        const __m256d absY = _mm256_andnot_pd(kSignMask, y);
+        const __m256d isSwapped = _mm256_cmp_pd(absY, absX, _CMP_GT_OQ);
+        const __m256d maxValue = _mm256_blendv_pd(absX, absY, isSwapped);
+        const __m256d minValue = _mm256_blendv_pd(absY, absX, isSwapped);
+        const __m256d ratio = _mm256_andnot_pd(_mm256_cmp_pd(maxValue, kZero, _CMP_EQ_OQ), _mm256_div_pd(minValue, maxValue));
+        const __m256d square = _mm256_mul_pd(ratio, ratio);
+
+        __m256d polynom = _mm256_set1_pd(kAtanCoefficients[kAtanCoefficientsCount - 1]);
+        for (size_t k = kAtanCoefficientsCount - 1; k > 0; --k)
+        {
+            polynom = _mm256_add_pd(_mm256_mul_pd(polynom, square), _mm256_set1_pd(kAtanCoefficients[k - 1]));
+        }
+
+        __m256d angle = _mm256_mul_pd(ratio, polynom);
+        angle = _mm256_blendv_pd(angle, _mm256_sub_pd(kHalfPi, angle), isSwapped);
+        // blendv выбирает по знаковому биту маски, поэтому знак x (включая -0.0) используется непосредственно.
+        angle = _mm256_blendv_pd(angle, _mm256_sub_pd(kPi, angle), x);
+        angle = _mm256_or_pd(angle, _mm256_and_pd(kSignMask, y));
+
+        _mm256_storeu_pd(result + i, _mm256_permute4x64_pd(angle, 0xD8));
+    }
+    scalarPhase(values + i, result + i, count - i);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// AVX-512F: восемь значений double в регистре.
+// Заголовки GCC заполняют неиспользуемый источник маскированных встроенных функций значением _mm512_undefined_*,
+// на что компилятор выдаёт ложное предупреждение о неинициализированной переменной.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+__attribute__((target("avx512f")))
+void avx512Multiply(const std::complex<double>* lhs,
+                    const std::complex<double>* rhs,
+                    std::complex<double>* result,
+                    const size_t count)
+{
+    const double* const kLhs = reinterpret_cast<const double*>(lhs);
+    const double* const kRhs = reinterpret_cast<const double*>(rhs);
+    double* const kResult = reinterpret_cast<double*>(result);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m512d a = _mm512_loadu_pd(kLhs + 2 * i);
+        const __m512d b = _mm512_loadu_pd(kRhs + 2 * i);
+        const __m512d bRe = _mm512_movedup_pd(b);
+        const __m512d bIm = _mm512_permute_pd(b, 0xFF);
+        const __m512d aSwapped = _mm512_permute_pd(a, 0x55);
+        _mm512_storeu_pd(kResult + 2 * i, _mm512_fmaddsub_pd(a, bRe, _mm512_mul_pd(aSwapped, bIm)));
+    }
+    scalarMultiply(lhs + i, rhs + i, result + i, count - i);
+}
+
+__attribute__((target("avx512f")))
+inline void avx512Split(const double* values, __m512d& x, __m512d& y)
+{
+    const __m512i kEven = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+    const __m512i kOdd = _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1);
+    const __m512d v0 = _mm512_loadu_pd(values);
+    const __m512d v1 = _mm512_loadu_pd(values + 8);
+    x = _mm512_permutex2var_pd(v0, kEven, v1);
+    y = _mm512_permutex2var_pd(v0, kOdd, v1);
+}
+
+__attribute__((target("avx512f")))
+void avx512SquaredMagnitude(const std::complex<double>* values, double* result, const size_t count)
+{
+    const double* const kValues = reinterpret_cast<const double*>(values);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d x, y;
+        avx512Split(kValues + 2 * i, x, y);
+        _mm512_storeu_pd(result + i, _mm512_add_pd(_mm512_mul_pd(x, x), _mm512_mul_pd(y, y)));
+    }
+    scalarSquaredMagnitude(values + i, result + i, count - i);
+}
+
+__attribute__((target("avx512f")))
+void avx512Magnitude(const std::complex<double>* values, double* result, const size_t count)
+{
+    const double* const kValues = reinterpret_cast<const double*>(values);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d x, y;
+        avx512Split(kValues + 2 * i, x, y);
+        _mm512_storeu_pd(result + i, _mm512_sqrt_pd(_mm512_add_pd(_mm512_mul_pd(x, x), _mm512_mul_pd(y, y))));
+    }
+    scalarMagnitude(values + i, result + i, count - i);
+}
+
+__attribute__((target("avx512f")))
+void avx512Phase(const std::complex<double>* values, double* result, const size_t count)
+{
+    const double* const kValues = reinterpret_cast<const double*>(values);
+    const __m512i kSignMask = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ULL));
+    const __m512d kZero = _mm512_setzero_pd();
+    const __m512d kHalfPi = _mm512_set1_pd(M_PI_2);
+    const __m512d kPi = _mm512_set1_pd(M_PI);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m512d x, y;
+        avx512Split(kValues + 2 * i, x, y);
+
+        const __m512d absX = _mm512_castsi512_pd(_mm512_andnot_epi64(kSignMask, _mm512_castpd_si512(x)));
+        const __m512d absY = _mm512_castsi512_pd(_mm512_andnot_epi64(kSignMask, _mm512_castpd_si512(y)));
+        const __mmask8 isSwapped = _mm512_cmp_pd_mask(absY, absX, _CMP_GT_OQ);
+        const __m512d maxValue = _mm512_mask_blend_pd(isSwapped, absX, absY);
+        const __m512d minValue = _mm512_mask_blend_pd(isSwapped, absY, absX);
+        const __mmask8 isZero = _mm512_cmp_pd_mask(maxValue, kZero, _CMP_EQ_OQ);
+        const __m512d ratio = _mm512_mask_blend_pd(isZero, _mm512_div_pd(minValue, maxValue), kZero);
+        const __m512d square = _mm512_mul_pd(ratio, ratio);
+
+        __m512d polynom = _mm512_set1_pd(kAtanCoefficients[kAtanCoefficientsCount - 1]);
+        for (size_t k = kAtanCoefficientsCount - 1; k > 0; --k)
+        {
+            polynom = _mm512_add_pd(_mm512_mul_pd(polynom, square), _mm512_set1_pd(kAtanCoefficients[k - 1]));
+        }
+
+        __m512d angle = _mm512_mul_pd(ratio, polynom);
+        angle = _mm512_mask_blend_pd(isSwapped, angle, _mm512_sub_pd(kHalfPi, angle));
+        const __mmask8 isNegativeX = _mm512_test_epi64_mask(_mm512_castpd_si512(x), kSignMask);
+        angle = _mm512_mask_blend_pd(isNegativeX, angle, _mm512_sub_pd(kPi, angle));
+        angle = _mm512_castsi512_pd(_mm512_or_epi64(_mm512_castpd_si512(angle),
+                                                    _mm512_and_epi64(kSignMask, _mm512_castpd_si512(y))));
+
+        _mm512_storeu_pd(result + i, angle);
+    }
+    scalarPhase(values + i, result + i, count - i);
+}
+
+#pragma GCC diagnostic pop
+
+#endif // FOURIER_SIMD_X86
+
+/**
+ * @struct Kernels
+ * @brief Набор реализаций вычислительных ядер для выбранного набора инструкций.
+ */
+struct Kernels
+{
+    simd::InstructionSet instructionSet = simd::InstructionSet::Scalar;
+    void (*multiply)(const std::complex<double>*, const std::complex<double>*, std::complex<double>*, const size_t) = &scalarMultiply;
+    void (*magnitude)(const std::complex<double>*, double*, const size_t) = &scalarMagnitude;
+    void (*squaredMagnitude)(const std::complex<double>*, double*, const size_t) = &scalarSquaredMagnitude;
+    void (*phase)(const std::complex<double>*, double*, const size_t) = &scalarPhase;
+};
+
+/**
+ * @brief supportedInstructionSet - наилучший набор инструкций, поддерживаемый процессором.
+ */
+simd::InstructionSet supportedInstructionSet()
+{
+#ifdef FOURIER_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return simd::InstructionSet::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return simd::InstructionSet::Avx2;
+    }
+    return simd::InstructionSet::Sse2;
+#else
+    return simd::InstructionSet::Scalar;
+#endif
+}
+
+/**
+ * @brief requestedInstructionSet - ограничение набора инструкций из переменной окружения FOURIER_SIMD.
+ */
+simd::InstructionSet requestedInstructionSet()
+{
+    const char* const kRequested = std::getenv("FOURIER_SIMD");
+    if (kRequested == nullptr)
+    {
+        return simd::InstructionSet::Avx512;
+    }
+
+    for (const simd::InstructionSet each : { simd::InstructionSet::Scalar,
+                                             simd::InstructionSet::Sse2,
+                                             simd::InstructionSet::Avx2 })
+    {
+        if (simd::instructionSetName(each) == kRequested)
+        {
+            return each;
+        }
+    }
+    return simd::InstructionSet::Avx512;
+}
+
+const Kernels makeKernels()
+{
+    const simd::InstructionSet kSupported = supportedInstructionSet();
+    const simd::InstructionSet kRequested = requestedInstructionSet();
+
+    Kernels result;
+    result.instructionSet = (static_cast<int>(kRequested) < static_cast<int>(kSupported) ? kRequested : kSupported);
+
+#ifdef FOURIER_SIMD_X86
+    switch (result.instructionSet)
+    {
+    case simd::InstructionSet::Avx512:
+        result.multiply = &avx512Multiply;
+        result.magnitude = &avx512Magnitude;
+        result.squaredMagnitude = &avx512SquaredMagnitude;
+        result.phase = &avx512Phase;
+        break;
+    case simd::InstructionSet::Avx2:
+        result.multiply = &avx2Multiply;
+        result.magnitude = &avx2Magnitude;
+        result.squaredMagnitude = &avx2SquaredMagnitude;
+        result.phase = &avx2Phase;
+        break;
+    case simd::InstructionSet::Sse2:
+        result.multiply = &sse2Multiply;
+        result.magnitude = &sse2Magnitude;
+        result.squaredMagnitude = &sse2SquaredMagnitude;
+        result.phase = &sse2Phase;
+        break;
+    default:
+        break;
+    }
+#endif
+
+    return result;
+}
+
+const Kernels& kernels()
+{
+    static const Kernels kKernels = makeKernels();
+    return kKernels;
+}
+
+}
+
+namespace simd
+{
+
+InstructionSet activeInstructionSet()
+{
+    return ::kernels().instructionSet;
+}
+
+const std::string instructionSetName(const InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+    case InstructionSet::Scalar:
+        return "scalar";
+    case InstructionSet::Sse2:
+        return "sse2";
+    case InstructionSet::Avx2:
+        return "avx2";
+    case InstructionSet::Avx512:
+        return "avx512";
+    default:
+        break;
+    }
+    return std::string();
+}
+
+void multiply(const std::complex<double>* lhs,
+              const std::complex<double>* rhs,
+              std::complex<double>* result,
+              const size_t count)
+{
+    ::kernels().multiply(lhs, rhs, result, count);
+}
+
+void magnitude(const std::complex<double>* values, double* result, const size_t count)
+{
+    ::kernels().magnitude(values, result, count);
+}
+
+void squaredMagnitude(const std::complex<double>* values, double* result, const size_t count)
+{
+    ::kernels().squaredMagnitude(values, result, count);
+}
+
+void phase(const std::complex<double>* values, double* result, const size_t count)
+{
+    ::kernels().phase(values, result, count);
+}
+
+} // simd
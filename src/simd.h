@@ -0,0 +1,83 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <complex>
+#include <cstddef>
+#include <string>
+
+/**
+ * Векторизованные (SIMD) вычислительные ядра для поэлементной обработки спектров.
+ * Реализация выбирается при первом обращении по возможностям процессора (AVX-512, AVX2, SSE2)
+ * с переносимым скалярным вариантом для прочих платформ. Выбор можно ограничить сверху
+ * переменной окружения FOURIER_SIMD (scalar, sse2, avx2, avx512).
+ */
+namespace simd
+{
+/**
+ * @brief InstructionSet - набор инструкций, используемый вычислительными ядрами.
+ */
+enum class InstructionSet
+{
+    Scalar,
+    Sse2,
+    Avx2,
+    Avx512
+};
+
+/**
+ * @brief kPhaseMaxError - наибольшая абсолютная погрешность (в радианах) приближения функции phase
+ *        относительно std::atan2 для конечных аргументов.
+ */
+const double kPhaseMaxError = 3.0e-9;
+
+/**
+ * @brief activeInstructionSet - набор инструкций, выбранный для вычислительных ядер.
+ */
+InstructionSet activeInstructionSet();
+
+/**
+ * @brief instructionSetName - название набора инструкций.
+ */
+const std::string instructionSetName(const InstructionSet instructionSet);
+
+/**
+ * @brief multiply - поэлементное произведение комплексных последовательностей: result[i] = lhs[i] * rhs[i].
+ *        Допускается совпадение result с lhs или rhs.
+ * @param lhs - первый множитель.
+ * @param rhs - второй множитель.
+ * @param result - произведение.
+ * @param count - длина последовательностей.
+ */
+void multiply(const std::complex<double>* lhs,
+              const std::complex<double>* rhs,
+              std::complex<double>* result,
+              const size_t count);
+
+/**
+ * @brief magnitude - поэлементный модуль: result[i] = sqrt(re^2 + im^2) (совпадает с modulus).
+ * @param values - комплексная последовательность.
+ * @param result - модули значений.
+ * @param count - длина последовательности.
+ */
+void magnitude(const std::complex<double>* values, double* result, const size_t count);
+
+/**
+ * @brief squaredMagnitude - поэлементный квадрат модуля: result[i] = re^2 + im^2.
+ * @param values - комплексная последовательность.
+ * @param result - квадраты модулей значений.
+ * @param count - длина последовательности.
+ */
+void squaredMagnitude(const std::complex<double>* values, double* result, const size_t count);
+
+/**
+ * @brief phase - поэлементный аргумент: result[i] ~ atan2(im, re) с погрешностью не более kPhaseMaxError.
+ *        Используется полиномиальное приближение арктангенса на [0, 1] с приведением по октантам.
+ * @param values - комплексная последовательность.
+ * @param result - аргументы значений в диапазоне [-pi, pi].
+ * @param count - длина последовательности.
+ */
+void phase(const std::complex<double>* values, double* result, const size_t count);
+
+} // simd
+
+#endif // SIMD_H
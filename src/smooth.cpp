@@ -0,0 +1,213 @@
+#include "smooth.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <numeric>
+
+namespace
+{
+/**
+ * @brief copyEdges - копирует несглаживаемые значения у краёв последовательности (при обработке не на месте).
+ */
+void copyEdges(Span<const double> input, const size_t width, Span<double> output)
+{
+    if (input.data() == output.data())
+    {
+        return;
+    }
+
+    if (input.size() < width)
+    {
+        std::copy(std::begin(input), std::end(input), std::begin(output));
+        return;
+    }
+
+    const size_t kHead = width / 2;
+    const size_t kTail = width - 1 - kHead;
+    std::copy(input.begin(), input.begin() + kHead, output.begin());
+    std::copy(input.end() - kTail, input.end(), output.end() - kTail);
+}
+
+/**
+ * @brief smoothCentred - центрированное сглаживание окном width: значение с индексом i + width/2 заменяется
+ *        результатом smoother для значений [i, i + width). Исходные значения окна хранятся в smoother,
+ *        поэтому запись результата (не далее прочитанного значения) допускает обработку на месте.
+ */
+template <typename Smoother, typename Result>
+void smoothCentred(Span<const double> input,
+                   const size_t width,
+                   Span<double> output,
+                   Smoother& smoother,
+                   Result result)
+{
+    assert(width > 0);
+    assert(output.size() == input.size());
+
+    ::copyEdges(input, width, output);
+    if (input.size() < width)
+    {
+        return;
+    }
+
+    const size_t kShift = width - 1 - width / 2;
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        smoother.push(input[i]);
+        if (smoother.isFull())
+        {
+            output[i - kShift] = result(smoother);
+        }
+    }
+}
+
+}
+
+namespace smoothing
+{
+
+MovingAverage::MovingAverage(const size_t width) :
+    m_values(std::max<size_t>(width, 1), 0.0)
+{ }
+
+void MovingAverage::push(const double value)
+{
+    double& slot = m_values[m_count % m_values.size()];
+    m_sum += value - slot;
+    slot = value;
+    ++m_count;
+
+    if (m_count % m_values.size() == 0)
+    {
+        // Сумма кольцевого буфера пересчитывается один раз на width значений: O(1) в среднем на значение.
+        m_sum = std::accumulate(std::begin(m_values), std::end(m_values), 0.0);
+    }
+}
+
+double MovingAverage::mean() const
+{
+    const size_t kCount = std::min(m_count, m_values.size());
+    return (kCount > 0 ? m_sum / kCount : 0.0);
+}
+
+double MovingAverage::value(const size_t index) const
+{
+    assert(index < m_count && index + m_values.size() >= m_count);
+    return m_values[index % m_values.size()];
+}
+
+ExponentialMovingAverage::ExponentialMovingAverage(const double alpha) :
+    m_alpha(alpha)
+{
+    assert(alpha > 0.0 && alpha <= 1.0);
+}
+
+void ExponentialMovingAverage::push(const double value)
+{
+    if (m_isEmpty)
+    {
+        m_mean = value;
+        m_isEmpty = false;
+        return;
+    }
+    m_mean += m_alpha * (value - m_mean);
+}
+
+MovingMedian::MovingMedian(const size_t width) :
+    m_values(std::max<size_t>(width, 1), 0.0)
+{ }
+
+void MovingMedian::push(const double value)
+{
+    double& slot = m_values[m_count % m_values.size()];
+    if (isFull())
+    {
+        erase(slot);
+    }
+    slot = value;
+    ++m_count;
+
+    insert(value);
+    balance();
+}
+
+double MovingMedian::median() const
+{
+    if (m_lower.empty())
+    {
+        return 0.0;
+    }
+    if (m_lower.size() > m_upper.size())
+    {
+        return *m_lower.rbegin();
+    }
+    return 0.5 * (*m_lower.rbegin() + *m_upper.begin());
+}
+
+void MovingMedian::insert(const double value)
+{
+    if (!m_upper.empty() && value >= *m_upper.begin())
+    {
+        m_upper.insert(value);
+    }
+    else
+    {
+        m_lower.insert(value);
+    }
+}
+
+void MovingMedian::erase(const double value)
+{
+    const auto kLower = m_lower.find(value);
+    if (kLower != std::end(m_lower))
+    {
+        m_lower.erase(kLower);
+    }
+    else
+    {
+        m_upper.erase(m_upper.find(value));
+    }
+}
+
+void MovingMedian::balance()
+{
+    // Нижняя половина содержит столько же значений, сколько верхняя, или на одно больше.
+    while (m_lower.size() > m_upper.size() + 1)
+    {
+        const auto kLargest = std::prev(std::end(m_lower));
+        m_upper.insert(*kLargest);
+        m_lower.erase(kLargest);
+    }
+    while (m_upper.size() > m_lower.size())
+    {
+        const auto kSmallest = std::begin(m_upper);
+        m_lower.insert(*kSmallest);
+        m_upper.erase(kSmallest);
+    }
+}
+
+void movingAverage(Span<const double> input, const size_t width, Span<double> output)
+{
+    MovingAverage average(width);
+    ::smoothCentred(input, width, output, average, [](const MovingAverage& each) { return each.mean(); });
+}
+
+void exponentialMovingAverage(Span<const double> input, const double alpha, Span<double> output)
+{
+    assert(output.size() == input.size());
+
+    ExponentialMovingAverage average(alpha);
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        average.push(input[i]);
+        output[i] = average.mean();
+    }
+}
+
+void movingMedian(Span<const double> input, const size_t width, Span<double> output)
+{
+    MovingMedian median(width);
+    ::smoothCentred(input, width, output, median, [](const MovingMedian& each) { return each.median(); });
+}
+
+} // smoothing
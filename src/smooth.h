@@ -0,0 +1,129 @@
+#ifndef SMOOTH_H
+#define SMOOTH_H
+
+#include <set>
+#include <vector>
+
+#include "span.h"
+
+namespace smoothing
+{
+/**
+ * @class MovingAverage
+ * @brief Скользящее среднее последних width значений за O(1) на значение (сумма окна обновляется рекуррентно).
+ *        Последние width значений хранятся в кольцевом буфере; сумма периодически пересчитывается точно,
+ *        чтобы погрешность рекуррентного обновления не накапливалась.
+ */
+class MovingAverage
+{
+public:
+    explicit MovingAverage(const size_t width);
+
+    /**
+     * @brief push - добавляет очередное значение (вытесняя значение, добавленное width значений назад).
+     */
+    void push(const double value);
+
+    /**
+     * @brief isFull - добавлено ли не менее width значений (окно заполнено).
+     */
+    bool isFull() const { return (m_count >= m_values.size()); }
+
+    /**
+     * @brief mean - среднее значений окна (до заполнения окна - среднее добавленных значений).
+     */
+    double mean() const;
+
+    /**
+     * @brief value - значение, добавленное под номером index (одно из последних width значений).
+     */
+    double value(const size_t index) const;
+
+    size_t width() const { return m_values.size(); }
+    size_t count() const { return m_count; }
+
+private:
+    std::vector<double> m_values;
+    double m_sum = 0.0;
+    size_t m_count = 0;
+};
+
+/**
+ * @class ExponentialMovingAverage
+ * @brief Экспоненциальное скользящее среднее: mean = mean + alpha * (value - mean), первое значение принимается как есть.
+ */
+class ExponentialMovingAverage
+{
+public:
+    explicit ExponentialMovingAverage(const double alpha);
+
+    void push(const double value);
+    double mean() const { return m_mean; }
+    bool empty() const { return m_isEmpty; }
+
+private:
+    double m_alpha = 1.0;
+    double m_mean = 0.0;
+    bool m_isEmpty = true;
+};
+
+/**
+ * @class MovingMedian
+ * @brief Скользящая медиана последних width значений за O(log width) на значение.
+ *        Значения окна разделены на две упорядоченные половины (аналог двух куч с удалением произвольного элемента):
+ *        в нижней - не больше половины значений, все не больше значений верхней половины.
+ */
+class MovingMedian
+{
+public:
+    explicit MovingMedian(const size_t width);
+
+    void push(const double value);
+    bool isFull() const { return (m_count >= m_values.size()); }
+
+    /**
+     * @brief median - медиана значений окна (для чётного количества значений - среднее двух средних значений).
+     */
+    double median() const;
+
+    size_t width() const { return m_values.size(); }
+    size_t count() const { return m_count; }
+
+private:
+    void insert(const double value);
+    void erase(const double value);
+    void balance();
+
+private:
+    std::vector<double> m_values;     //!< Последние width значений (кольцевой буфер).
+    std::multiset<double> m_lower;
+    std::multiset<double> m_upper;
+    size_t m_count = 0;
+};
+
+/**
+ * @brief movingAverage - центрированное скользящее среднее последовательности input по окну width:
+ *        значение с индексом i + width/2 заменяется средним значений [i, i + width). Значения у краёв, для которых
+ *        окно выходит за пределы последовательности, не сглаживаются (если последовательность короче окна - не сглаживается вся).
+ *        O(1) на значение; допускается обработка на месте (output совпадает с input).
+ * @param input - входная последовательность.
+ * @param width - ширина окна (не менее 1).
+ * @param output - сглаженная последовательность (input.size() значений).
+ */
+void movingAverage(Span<const double> input, const size_t width, Span<double> output);
+
+/**
+ * @brief exponentialMovingAverage - экспоненциальное скользящее среднее последовательности input с коэффициентом alpha из (0, 1].
+ *        Допускается обработка на месте.
+ */
+void exponentialMovingAverage(Span<const double> input, const double alpha, Span<double> output);
+
+/**
+ * @brief movingMedian - центрированная скользящая медиана последовательности input по окну width
+ *        (края обрабатываются так же, как в movingAverage). O(log width) на значение; допускается обработка на месте.
+ */
+void movingMedian(Span<const double> input, const size_t width, Span<double> output);
+
+} // smoothing
+
+#endif // SMOOTH_H
@@ -0,0 +1,83 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class Span
+ * @brief Невладеющее представление непрерывной последовательности значений: указатель и длина
+ *        (аналог std::span для C++14). Позволяет передавать в функции обработки часть существующего
+ *        буфера (например, окно сигнала) без копирования.
+ *        Неявно создаётся из std::vector, Span<const T> - также из Span<T>.
+ *
+ * @note Представление действительно, пока существует исходный буфер и не изменяется его размер.
+ */
+template <typename T>
+class Span
+{
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using iterator = T*;
+
+    Span() = default;
+
+    Span(T* data, const size_t size) :
+        m_data(data),
+        m_size(size)
+    { }
+
+    Span(T* first, T* last) :
+        m_data(first),
+        m_size(static_cast<size_t>(last - first))
+    { }
+
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    Span(std::vector<U>& values) :
+        m_data(values.data()),
+        m_size(values.size())
+    { }
+
+    template <typename U, typename = typename std::enable_if<std::is_convertible<const U*, T*>::value>::type>
+    Span(const std::vector<U>& values) :
+        m_data(values.data()),
+        m_size(values.size())
+    { }
+
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    Span(const Span<U>& other) :
+        m_data(other.data()),
+        m_size(other.size())
+    { }
+
+    T* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return (m_size == 0); }
+
+    iterator begin() const { return m_data; }
+    iterator end() const { return m_data + m_size; }
+
+    T& operator[](const size_t index) const
+    {
+        assert(index < m_size);
+        return m_data[index];
+    }
+
+    /**
+     * @brief subspan - часть последовательности длиной count, начиная с offset (не далее конца последовательности).
+     */
+    Span subspan(const size_t offset, const size_t count) const
+    {
+        assert(offset <= m_size);
+        return Span(m_data + offset, (count < m_size - offset ? count : m_size - offset));
+    }
+
+private:
+    T* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+#endif // SPAN_H
@@ -0,0 +1,221 @@
+#include "stft.h"
+
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#include "cache.h"
+#include "fft.h"
+#include "simd.h"
+
+namespace
+{
+/**
+ * @brief kWindowsCacheBytesLimit - бюджет кэша коэффициентов оконных функций (в байтах).
+ */
+const size_t kWindowsCacheBytesLimit = 16 * 1024 * 1024;
+
+/**
+ * @brief kFramesGrain - количество кадров, обрабатываемых потоком за один раз.
+ */
+const size_t kFramesGrain = 16;
+
+using WindowKey = std::pair<int, size_t>;
+using WindowsCache = cache::LruCache<WindowKey, std::vector<double>>;
+
+WindowsCache& windowsCache()
+{
+    static WindowsCache coefficientsCache(kWindowsCacheBytesLimit);
+    return coefficientsCache;
+}
+
+std::vector<double> makeWindow(const fourier::WindowFunction type, const size_t length)
+{
+    std::vector<double> result(length, 1.0);
+    for (size_t n = 0; n < length; ++n)
+    {
+        const double kPhase = 2.0 * M_PI * static_cast<double>(n) / static_cast<double>(length);
+        switch (type)
+        {
+        case fourier::WindowFunction::Hann:
+            result[n] = 0.5 - 0.5 * std::cos(kPhase);
+            break;
+        case fourier::WindowFunction::Hamming:
+            result[n] = 0.54 - 0.46 * std::cos(kPhase);
+            break;
+        case fourier::WindowFunction::Blackman:
+            result[n] = 0.42 - 0.5 * std::cos(kPhase) + 0.08 * std::cos(2.0 * kPhase);
+            break;
+        case fourier::WindowFunction::Rectangular:
+        default:
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ * @struct FrameWorkspace
+ * @brief План преобразования и рабочие буферы одного потока.
+ */
+struct FrameWorkspace
+{
+    fourier::RealFftPlan plan;
+    std::vector<double> frame;
+    std::vector<std::complex<double>> spectrum;
+
+    explicit FrameWorkspace(const size_t frameLength) :
+        plan(frameLength),
+        frame(frameLength),
+        spectrum(plan.spectrumSize())
+    { }
+};
+
+/**
+ * @brief computeFrames - вычисляет строки [first, last) спектрограммы result сигнала signal.
+ */
+void computeFrames(Span<const double> signal,
+                   const std::vector<double>& window,
+                   const double scale,
+                   const size_t first,
+                   const size_t last,
+                   FrameWorkspace& workspace,
+                   fourier::Spectrogram& result)
+{
+    const size_t kFrameLength = result.frameLength();
+    for (size_t frame = first; frame < last; ++frame)
+    {
+        const double* const kSamples = signal.data() + result.frameStart(frame);
+        for (size_t n = 0; n < kFrameLength; ++n)
+        {
+            workspace.frame[n] = kSamples[n] * window[n];
+        }
+
+        workspace.plan.forward(workspace.frame, workspace.spectrum);
+
+        Span<double> row = result.row(frame);
+        simd::magnitude(workspace.spectrum.data(), row.data(), row.size());
+        for (double& each : row)
+        {
+            each *= scale;
+        }
+    }
+}
+
+/**
+ * @brief makeSpectrogram - создаёт спектрограмму нужного размера для сигнала длины signalLength.
+ */
+fourier::Spectrogram makeSpectrogram(const size_t signalLength, const size_t frameLength, const size_t hop)
+{
+    assert(hop > 0);
+    const size_t kFramesCount = (frameLength > 0 && signalLength >= frameLength ? (signalLength - frameLength) / hop + 1 : 0);
+    return fourier::Spectrogram(kFramesCount, frameLength / 2 + 1, frameLength, hop);
+}
+
+/**
+ * @brief windowScale - множитель нормировки модулей спектра на сумму коэффициентов окна.
+ */
+double windowScale(const std::vector<double>& window)
+{
+    const double kSum = std::accumulate(std::begin(window), std::end(window), 0.0);
+    return (kSum > 0.0 ? 1.0 / kSum : 0.0);
+}
+
+}
+
+namespace fourier
+{
+
+std::shared_ptr<const std::vector<double>> windowCoefficients(const WindowFunction type, const size_t length)
+{
+    return ::windowsCache().get({ static_cast<int>(type), length },
+                                [type, length]() { return ::makeWindow(type, length); });
+}
+
+Spectrogram::Spectrogram(const size_t framesCount,
+                         const size_t binsCount,
+                         const size_t frameLength,
+                         const size_t hop) :
+    m_framesCount(framesCount),
+    m_binsCount(binsCount),
+    m_frameLength(frameLength),
+    m_hop(hop)
+{
+    // Длина строки в памяти дополняется до целого числа строк кэша.
+    const size_t kValuesPerLine = kCacheLineSize / sizeof(double);
+    m_stride = (m_binsCount + kValuesPerLine - 1) / kValuesPerLine * kValuesPerLine;
+    m_values.assign(m_framesCount * m_stride, 0.0);
+}
+
+Span<const double> Spectrogram::row(const size_t frame) const
+{
+    assert(frame < m_framesCount);
+    return Span<const double>(m_values.data() + frame * m_stride, m_binsCount);
+}
+
+Span<double> Spectrogram::row(const size_t frame)
+{
+    assert(frame < m_framesCount);
+    return Span<double>(m_values.data() + frame * m_stride, m_binsCount);
+}
+
+const std::vector<double> Spectrogram::column(const size_t bin) const
+{
+    assert(bin < m_binsCount);
+    std::vector<double> result(m_framesCount);
+    for (size_t frame = 0; frame < m_framesCount; ++frame)
+    {
+        result[frame] = m_values[frame * m_stride + bin];
+    }
+    return result;
+}
+
+Spectrogram stft(Span<const double> signal,
+                 const size_t frameLength,
+                 const size_t hop,
+                 const WindowFunction window)
+{
+    Spectrogram result = ::makeSpectrogram(signal.size(), frameLength, hop);
+    if (result.framesCount() == 0)
+    {
+        return result;
+    }
+
+    const auto kWindow = windowCoefficients(window, frameLength);
+    FrameWorkspace workspace(frameLength);
+    ::computeFrames(signal, *kWindow, ::windowScale(*kWindow), 0, result.framesCount(), workspace, result);
+    return result;
+}
+
+Spectrogram stft(Span<const double> signal,
+                 const size_t frameLength,
+                 const size_t hop,
+                 const WindowFunction window,
+                 ThreadPool& pool)
+{
+    Spectrogram result = ::makeSpectrogram(signal.size(), frameLength, hop);
+    if (result.framesCount() == 0)
+    {
+        return result;
+    }
+
+    const auto kWindow = windowCoefficients(window, frameLength);
+    const double kScale = ::windowScale(*kWindow);
+
+    std::vector<std::unique_ptr<FrameWorkspace>> workspaces(pool.size());
+    pool.parallelFor(result.framesCount(),
+                     kFramesGrain,
+                     [&](const size_t first, const size_t last, const size_t worker)
+                     {
+                         if (!workspaces[worker])
+                         {
+                             workspaces[worker].reset(new FrameWorkspace(frameLength));
+                         }
+                         ::computeFrames(signal, *kWindow, kScale, first, last, *workspaces[worker], result);
+                     });
+
+    return result;
+}
+
+} // fourier
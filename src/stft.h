@@ -0,0 +1,118 @@
+#ifndef STFT_H
+#define STFT_H
+
+#include <memory>
+#include <vector>
+
+#include "aligned.h"
+#include "span.h"
+#include "threadpool.h"
+
+namespace fourier
+{
+/**
+ * @brief WindowFunction - оконная функция кадра кратковременного преобразования Фурье.
+ */
+enum class WindowFunction
+{
+    Rectangular,
+    Hann,
+    Hamming,
+    Blackman
+};
+
+/**
+ * @brief windowCoefficients - коэффициенты оконной функции type длины length (периодический вариант,
+ *        w[n] вычисляется для n / length). Коэффициенты вычисляются один раз для каждой пары (type, length)
+ *        и хранятся в разделяемом кэше.
+ * @param type - оконная функция.
+ * @param length - длина окна.
+ * @return коэффициенты окна.
+ */
+std::shared_ptr<const std::vector<double>> windowCoefficients(const WindowFunction type, const size_t length);
+
+/**
+ * @class Spectrogram
+ * @brief Спектрограмма: модули спектров кадров сигнала, хранящиеся непрерывной матрицей по строкам (строка - кадр).
+ *        Начало каждой строки выровнено по строке кэша (длина строки в памяти stride() не меньше binsCount()).
+ */
+class Spectrogram
+{
+public:
+    Spectrogram() = default;
+    Spectrogram(const size_t framesCount,
+                const size_t binsCount,
+                const size_t frameLength,
+                const size_t hop);
+
+    size_t framesCount() const { return m_framesCount; }
+    size_t binsCount() const { return m_binsCount; }
+    size_t stride() const { return m_stride; }
+    size_t frameLength() const { return m_frameLength; }
+    size_t hop() const { return m_hop; }
+
+    /**
+     * @brief frameStart - индекс первого отсчёта сигнала кадра frame.
+     */
+    size_t frameStart(const size_t frame) const { return frame * m_hop; }
+
+    /**
+     * @brief row - модули спектра кадра frame (binsCount() значений).
+     */
+    Span<const double> row(const size_t frame) const;
+    Span<double> row(const size_t frame);
+
+    /**
+     * @brief value - модуль отсчёта bin спектра кадра frame.
+     */
+    double value(const size_t frame, const size_t bin) const { return m_values[frame * m_stride + bin]; }
+
+    /**
+     * @brief column - изменение модуля отсчёта bin во времени (по одному значению на кадр).
+     */
+    const std::vector<double> column(const size_t bin) const;
+
+    /**
+     * @brief data - начало матрицы значений (framesCount() строк по stride() значений).
+     */
+    const double* data() const { return m_values.data(); }
+
+private:
+    size_t m_framesCount = 0;
+    size_t m_binsCount = 0;
+    size_t m_stride = 0;
+    size_t m_frameLength = 0;
+    size_t m_hop = 0;
+    AlignedVector<double> m_values;
+};
+
+/**
+ * @brief stft - кратковременное преобразование Фурье (спектрограмма) действительного сигнала signal.
+ *        Сигнал делится на кадры длины frameLength со смещением hop (кадры, выходящие за конец сигнала, не вычисляются),
+ *        каждый кадр умножается на оконную функцию и преобразуется быстрым преобразованием Фурье.
+ *        Модули спектра нормируются на сумму коэффициентов окна: синусоида амплитуды a, совпадающая с отсчётом спектра,
+ *        даёт значение a/2 (для прямоугольного окна - как у fourier::realDft).
+ * @param signal - анализируемый сигнал.
+ * @param frameLength - длина кадра.
+ * @param hop - смещение следующего кадра относительно предыдущего (не менее 1).
+ * @param window - оконная функция.
+ * @return спектрограмма: (signal.size() - frameLength) / hop + 1 кадров по frameLength/2+1 отсчётов.
+ */
+Spectrogram stft(Span<const double> signal,
+                 const size_t frameLength,
+                 const size_t hop,
+                 const WindowFunction window = WindowFunction::Hann);
+
+/**
+ * @brief stft - параллельный вариант кратковременного преобразования Фурье: кадры обрабатываются пакетами
+ *        в потоках пула pool, у каждого потока - свой план преобразования и рабочие буферы.
+ */
+Spectrogram stft(Span<const double> signal,
+                 const size_t frameLength,
+                 const size_t hop,
+                 const WindowFunction window,
+                 ThreadPool& pool);
+
+} // fourier
+
+#endif // STFT_H
@@ -0,0 +1,211 @@
+#include "streamingdecomposer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "commons.h"
+#include "decompose.h"
+#include "logger.h"
+
+namespace
+{
+/**
+ * @brief kReanchorWindows - количество окон, после которого сумма окна резонатора пересчитывается точно
+ *        (ограничивает накопление погрешности рекуррентного поворота множителей и рост их фаз).
+ */
+const size_t kReanchorWindows = 16;
+
+}
+
+StreamingDecomposer::StreamingDecomposer(const std::vector<double>& frequencies,
+                                         const WaveHandler& handler,
+                                         const StreamingDecomposerOptions& options) :
+    m_handler(handler),
+    m_options(options)
+{
+    size_t maxWidth = 1;
+    m_states.resize(frequencies.size());
+    for (size_t i = 0; i < frequencies.size(); ++i)
+    {
+        FrequencyState& state = m_states[i];
+        state.frequency = frequencies[i];
+        state.width = std::max<size_t>(frequencyToPeriod(state.frequency), 1);
+        state.maxGap = kMinimumWaveDurationPeriods * state.width;
+        state.decay = (options.normaliserHalfLifePeriods > 0.0 ? std::exp(-M_LN2 / (options.normaliserHalfLifePeriods * state.width))
+                                                               : 0.0);
+
+        const double kAngularFrequency = 1.0 / state.frequency;
+        state.step = std::polar(1.0, -kAngularFrequency);
+        state.entering = { 1.0, 0.0 };
+        state.leaving = std::polar(1.0, kAngularFrequency * state.width);
+        state.probabilities = smoothing::MovingAverage(state.width);
+
+        maxWidth = std::max(maxWidth, state.width);
+    }
+
+    m_history.assign(maxWidth + 1, 0.0);
+}
+
+void StreamingDecomposer::push(Span<const double> samples)
+{
+    if (m_isFinished)
+    {
+        Logger::warning("Streaming decomposition is already finished: " + std::to_string(samples.size()) + " samples ignored.");
+        return;
+    }
+
+    for (const double each : samples)
+    {
+        pushSample(each);
+    }
+}
+
+void StreamingDecomposer::finish()
+{
+    if (m_isFinished)
+    {
+        return;
+    }
+    m_isFinished = true;
+
+    for (FrequencyState& state : m_states)
+    {
+        // Значения в конце последовательности не сглаживаются (как и в начале, см. smoothing::movingAverage).
+        while (state.emittedCount < state.probabilities.count())
+        {
+            processSmooth(state, state.emittedCount, state.probabilities.value(state.emittedCount));
+        }
+
+        if (state.isSegmentOpen)
+        {
+            closeSegment(state);
+        }
+    }
+}
+
+size_t StreamingDecomposer::samplesCount() const
+{
+    return m_samplesCount;
+}
+
+void StreamingDecomposer::pushSample(const double sample)
+{
+    m_history[m_samplesCount % m_history.size()] = sample;
+
+    for (FrequencyState& state : m_states)
+    {
+        updateResonator(state);
+    }
+
+    ++m_samplesCount;
+}
+
+void StreamingDecomposer::updateResonator(FrequencyState& state)
+{
+    const size_t kIndex = m_samplesCount;
+    const size_t kWidth = state.width;
+
+    // Фазы множителей отсчитываются от anchor; модуль суммы окна от выбора anchor не зависит.
+    // Периодически anchor переносится на начало окна, а сумма пересчитывается точно.
+    if (kIndex - state.anchor >= (kReanchorWindows + 1) * kWidth)
+    {
+        const double kAngularFrequency = 1.0 / state.frequency;
+        state.anchor = kIndex - kWidth;
+        state.sum = { 0.0, 0.0 };
+        for (size_t m = state.anchor; m < kIndex; ++m)
+        {
+            state.sum += historyValue(m) * std::polar(1.0, -kAngularFrequency * (m - state.anchor));
+        }
+        state.entering = std::polar(1.0, -kAngularFrequency * kWidth);
+        state.leaving = { 1.0, 0.0 };
+    }
+
+    state.sum += historyValue(kIndex) * state.entering;
+    if (kIndex >= kWidth)
+    {
+        state.sum -= historyValue(kIndex - kWidth) * state.leaving;
+    }
+    state.entering *= state.step;
+    state.leaving *= state.step;
+
+    if (kIndex + 1 >= kWidth)
+    {
+        // Модуль суммы окна синусоиды амплитуды a составляет a * width / 2,
+        // поэтому вероятность соответствует оценке амплитуды частоты в окне.
+        pushProbability(state, 2.0 * std::abs(state.sum) / kWidth);
+    }
+}
+
+void StreamingDecomposer::pushProbability(FrequencyState& state, const double probability)
+{
+    const size_t kWidth = state.width;
+    const size_t kPosition = state.probabilities.count();
+    state.probabilities.push(probability);
+
+    // Скользящее среднее по width значениям относится к середине окна усреднения (как в smoothing::movingAverage);
+    // первые width/2 значений не сглаживаются.
+    if (kPosition < kWidth / 2)
+    {
+        processSmooth(state, kPosition, probability);
+    }
+    if (state.probabilities.isFull())
+    {
+        processSmooth(state, kPosition + 1 - kWidth + kWidth / 2, state.probabilities.mean());
+    }
+}
+
+void StreamingDecomposer::processSmooth(FrequencyState& state, const size_t position, const double value)
+{
+    state.level = std::max(value, state.level * state.decay);
+    const double kThreshold = std::max(kProbabilityThreshold * state.level, m_options.minimumProbability);
+
+    // Нулевые значения (например, тишина в начале сигнала) не открывают отрезок при нулевом пороге.
+    if (value >= kThreshold && value > 0.0)
+    {
+        if (!state.isSegmentOpen)
+        {
+            state.isSegmentOpen = true;
+            state.segmentStart = position;
+            state.segmentSum = 0.0;
+        }
+        state.segmentSum += value;
+        state.segmentEnd = position + 1;
+        state.segmentSumAtEnd = state.segmentSum;
+    }
+    else if (state.isSegmentOpen)
+    {
+        state.segmentSum += value;
+
+        // Отрезок завершается, как только промежуток после него превысил объединяемую длину.
+        if (position + 1 - state.segmentEnd > state.maxGap)
+        {
+            closeSegment(state);
+        }
+    }
+
+    ++state.emittedCount;
+}
+
+void StreamingDecomposer::closeSegment(FrequencyState& state)
+{
+    state.isSegmentOpen = false;
+
+    const size_t kLength = state.segmentEnd - state.segmentStart;
+    if (kLength < state.maxGap || !m_handler)
+    {
+        return;
+    }
+
+    const double kMeanValue = state.segmentSumAtEnd / kLength;
+    const double kConfidence = (state.level > 0.0 ? std::min(kMeanValue / state.level, 1.0) : 0.0);
+    m_handler(Wave(state.frequency,
+                   kConfidence,
+                   static_cast<unsigned int>(state.segmentStart),
+                   static_cast<unsigned int>(kLength)));
+}
+
+double StreamingDecomposer::historyValue(const size_t index) const
+{
+    return m_history[index % m_history.size()];
+}
@@ -0,0 +1,121 @@
+#ifndef STREAMINGDECOMPOSER_H
+#define STREAMINGDECOMPOSER_H
+
+#include <complex>
+#include <functional>
+#include <vector>
+
+#include "smooth.h"
+#include "span.h"
+#include "wave.h"
+
+/**
+ * @struct StreamingDecomposerOptions
+ * @brief Параметры нормировки вероятностей потоковой декомпозиции.
+ */
+struct StreamingDecomposerOptions
+{
+    double normaliserHalfLifePeriods = 1000.0; //!< Период полураспада затухающего максимума (в периодах частоты).
+    double minimumProbability = 0.0;           //!< Наименьший порог вероятности (оценки амплитуды частоты),
+                                               //!< отсекающий утечку соседних частот до появления искомой.
+};
+
+/**
+ * @class StreamingDecomposer
+ * @brief Потоковая декомпозиция сложного сигнала на базовые сигналы с заданными частотами.
+ *        Сигнал передаётся блоками отсчётов произвольной длины (push), обнаруженные отрезки
+ *        базовых сигналов передаются обработчику сразу после их завершения.
+ *
+ *        Для каждой частоты выполняются те же этапы, что и в decompose:
+ *        амплитуда частоты в скользящем окне шириной в один период (скользящий резонатор),
+ *        сглаживание скользящим средним, выделение отрезков выше порога kProbabilityThreshold
+ *        с объединением отрезков, разделённых промежутками не длиннее kMinimumWaveDurationPeriods периодов.
+ *        Вместо максимума по всему сигналу порог отсчитывается от затухающего максимума,
+ *        который уменьшается вдвое за normaliserHalfLifePeriods периодов частоты.
+ *
+ *        Хранится только история отсчётов длиной в наибольший период и по одному периоду
+ *        вероятностей для каждой частоты, поэтому объём памяти не зависит от длины сигнала.
+ *
+ * @note Экземпляр не предназначен для одновременного использования из нескольких потоков;
+ *       обработчик вызывается в потоке, выполняющем push или finish.
+ */
+class StreamingDecomposer
+{
+public:
+    using WaveHandler = std::function<void(const Wave&)>;
+
+    /**
+     * @brief StreamingDecomposer - создаёт декомпозицию для набора частот frequencies.
+     * @param frequencies - набор частот, составляющих сложный сигнал.
+     * @param handler - обработчик обнаруженных отрезков базовых сигналов.
+     * @param options - параметры нормировки.
+     */
+    StreamingDecomposer(const std::vector<double>& frequencies,
+                        const WaveHandler& handler,
+                        const StreamingDecomposerOptions& options = StreamingDecomposerOptions());
+
+    /**
+     * @brief push - обрабатывает очередной блок отсчётов сигнала.
+     * @param samples - отсчёты сигнала.
+     */
+    void push(Span<const double> samples);
+
+    /**
+     * @brief finish - завершает сигнал: обрабатывает отложенные сглаживанием значения
+     *        и передаёт обработчику незавершённые отрезки. Последующие вызовы push игнорируются.
+     */
+    void finish();
+
+    /**
+     * @brief samplesCount - количество обработанных отсчётов сигнала.
+     */
+    size_t samplesCount() const;
+
+private:
+    /**
+     * @struct FrequencyState
+     * @brief Состояние анализа одной частоты.
+     */
+    struct FrequencyState
+    {
+        double frequency = 0.0;
+        size_t width = 0;                     //!< Ширина окна (период частоты).
+        size_t maxGap = 0;                    //!< Наибольший объединяемый промежуток и наименьшая длина отрезка.
+        double decay = 1.0;                   //!< Множитель затухания максимума за один отсчёт.
+
+        std::complex<double> step;            //!< Поворот множителя при переходе к следующему отсчёту: exp(-i/frequency).
+        std::complex<double> entering;        //!< Множитель входящего в окно отсчёта.
+        std::complex<double> leaving;         //!< Множитель покидающего окно отсчёта.
+        std::complex<double> sum;             //!< Сумма окна с множителями относительно отсчёта anchor.
+        size_t anchor = 0;                    //!< Отсчёт, относительно которого отсчитываются фазы множителей.
+
+        smoothing::MovingAverage probabilities = smoothing::MovingAverage(1); //!< Последние width значений вероятности.
+        size_t emittedCount = 0;              //!< Количество обработанных сглаженных значений.
+
+        double level = 0.0;                   //!< Затухающий максимум сглаженной вероятности.
+        bool isSegmentOpen = false;
+        size_t segmentStart = 0;
+        size_t segmentEnd = 0;                //!< Конец отрезка: следующий за последним значением выше порога.
+        double segmentSum = 0.0;              //!< Сумма сглаженных значений от начала отрезка.
+        double segmentSumAtEnd = 0.0;         //!< Сумма сглаженных значений на [segmentStart, segmentEnd).
+    };
+
+    void pushSample(const double sample);
+    void updateResonator(FrequencyState& state);
+    void pushProbability(FrequencyState& state, const double probability);
+    void processSmooth(FrequencyState& state, const size_t position, const double value);
+    void closeSegment(FrequencyState& state);
+
+    double historyValue(const size_t index) const;
+
+private:
+    WaveHandler m_handler;
+    StreamingDecomposerOptions m_options;
+    std::vector<FrequencyState> m_states;
+
+    std::vector<double> m_history;            //!< Последние отсчёты сигнала (кольцевой буфер длиной в наибольший период + 1).
+    size_t m_samplesCount = 0;
+    bool m_isFinished = false;
+};
+
+#endif // STREAMINGDECOMPOSER_H
@@ -0,0 +1,215 @@
+#include "threadpool.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+
+/**
+ * @struct WorkRange
+ * @brief Оставшаяся часть диапазона одной рабочей очереди: владелец забирает фрагменты с начала, другие потоки - половину с конца.
+ */
+struct WorkRange
+{
+    std::mutex mutex;
+    size_t first = 0;
+    size_t last = 0;
+};
+
+/**
+ * @brief takeOwn - забирает из собственной очереди range фрагмент длиной не более grain.
+ * @return true, если фрагмент получен.
+ */
+bool takeOwn(WorkRange& range, const size_t grain, size_t& first, size_t& last)
+{
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.first == range.last)
+    {
+        return false;
+    }
+    first = range.first;
+    last = std::min(range.first + grain, range.last);
+    range.first = last;
+    return true;
+}
+
+/**
+ * @brief steal - переносит вторую половину оставшейся части очереди victim в очередь thief.
+ * @return true, если удалось что-либо перенести.
+ */
+bool steal(WorkRange& victim, WorkRange& thief)
+{
+    size_t first = 0;
+    size_t last = 0;
+    {
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.first == victim.last)
+        {
+            return false;
+        }
+        first = victim.first + (victim.last - victim.first) / 2;
+        last = victim.last;
+        victim.last = first;
+    }
+
+    std::lock_guard<std::mutex> lock(thief.mutex);
+    thief.first = first;
+    thief.last = last;
+    return true;
+}
+
+}
+
+ThreadPool::ThreadPool(const size_t threadsCount) :
+    m_nextTask(0)
+{
+    const size_t kThreadsCount = (threadsCount == 0 ? defaultThreadsCount() : threadsCount);
+    m_workers.reserve(kThreadsCount - 1);
+    for (size_t i = 1; i < kThreadsCount; ++i)
+    {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopped = true;
+    }
+    m_started.notify_all();
+
+    for (std::thread& each : m_workers)
+    {
+        each.join();
+    }
+}
+
+size_t ThreadPool::size() const
+{
+    return (m_workers.size() + 1);
+}
+
+size_t ThreadPool::defaultThreadsCount()
+{
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::run(const size_t tasksCount, const std::function<void(size_t)>& task)
+{
+    if (tasksCount == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_tasksCount = tasksCount;
+        m_nextTask = 0;
+        m_pendingWorkers = m_workers.size();
+        m_error = nullptr;
+        ++m_generation;
+    }
+    m_started.notify_all();
+
+    execute();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished.wait(lock, [this]() { return (m_pendingWorkers == 0); });
+    m_task = nullptr;
+
+    if (m_error != nullptr)
+    {
+        std::rethrow_exception(m_error);
+    }
+}
+
+void ThreadPool::parallelFor(const size_t count,
+                             const size_t grain,
+                             const std::function<void(size_t, size_t, size_t)>& body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    const size_t kQueuesCount = size();
+    const size_t kGrain = std::max<size_t>(grain, 1);
+    std::unique_ptr<WorkRange[]> ranges(new WorkRange[kQueuesCount]);
+    for (size_t i = 0; i < kQueuesCount; ++i)
+    {
+        ranges[i].first = i * count / kQueuesCount;
+        ranges[i].last = (i + 1) * count / kQueuesCount;
+    }
+
+    run(kQueuesCount,
+        [&](const size_t worker)
+        {
+            size_t first = 0;
+            size_t last = 0;
+            while (true)
+            {
+                if (::takeOwn(ranges[worker], kGrain, first, last))
+                {
+                    body(first, last, worker);
+                    continue;
+                }
+
+                bool isStolen = false;
+                for (size_t offset = 1; offset < kQueuesCount && !isStolen; ++offset)
+                {
+                    isStolen = ::steal(ranges[(worker + offset) % kQueuesCount], ranges[worker]);
+                }
+                if (!isStolen)
+                {
+                    return;
+                }
+            }
+        });
+}
+
+void ThreadPool::workerLoop()
+{
+    size_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_started.wait(lock, [this, generation]() { return (m_isStopped || m_generation != generation); });
+            if (m_isStopped)
+            {
+                return;
+            }
+            generation = m_generation;
+        }
+
+        execute();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_pendingWorkers;
+        }
+        m_finished.notify_one();
+    }
+}
+
+void ThreadPool::execute()
+{
+    for (size_t index = m_nextTask++; index < m_tasksCount; index = m_nextTask++)
+    {
+        try
+        {
+            (*m_task)(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_error == nullptr)
+            {
+                m_error = std::current_exception();
+            }
+        }
+    }
+}
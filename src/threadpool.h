@@ -0,0 +1,82 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Пул потоков для параллельного выполнения набора независимых задач.
+ *        Задачи пронумерованы [0, tasksCount) и разбираются потоками по мере освобождения;
+ *        вызывающий поток также участвует в выполнении.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief ThreadPool - создаёт пул из threadsCount потоков (включая вызывающий поток).
+     * @param threadsCount - общее количество потоков; 0 - по количеству ядер процессора.
+     */
+    explicit ThreadPool(const size_t threadsCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief size - общее количество потоков пула (включая вызывающий поток).
+     */
+    size_t size() const;
+
+    /**
+     * @brief run - выполняет задачи task(0), ..., task(tasksCount - 1) и дожидается их завершения.
+     *        Если какая-либо задача завершилась исключением, оно пробрасывается вызывающей стороне.
+     * @param tasksCount - количество задач.
+     * @param task - задача, вызываемая с номером задачи.
+     */
+    void run(const size_t tasksCount, const std::function<void(size_t)>& task);
+
+    /**
+     * @brief parallelFor - обрабатывает диапазон [0, count) фрагментами не длиннее grain с перехватом работы (work stealing).
+     *        Изначально диапазон делится поровну между потоками; поток, исчерпавший свою часть,
+     *        забирает вторую половину оставшейся части у другого потока.
+     * @param count - длина диапазона.
+     * @param grain - наибольшая длина фрагмента, передаваемого в body за один вызов.
+     * @param body - обработчик фрагмента [first, last); worker - номер рабочей очереди в [0, size()),
+     *        который в каждый момент времени используется только одним потоком (например, для выбора рабочего буфера).
+     */
+    void parallelFor(const size_t count,
+                     const size_t grain,
+                     const std::function<void(size_t first, size_t last, size_t worker)>& body);
+
+    /**
+     * @brief defaultThreadsCount - количество потоков по умолчанию (количество ядер процессора, но не менее 1).
+     */
+    static size_t defaultThreadsCount();
+
+private:
+    void workerLoop();
+    void execute();
+
+private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_started;
+    std::condition_variable m_finished;
+
+    const std::function<void(size_t)>* m_task = nullptr;
+    size_t m_tasksCount = 0;
+    std::atomic<size_t> m_nextTask;
+    size_t m_generation = 0;
+    size_t m_pendingWorkers = 0;
+    bool m_isStopped = false;
+    std::exception_ptr m_error;
+};
+
+#endif // THREADPOOL_H